@@ -3,6 +3,12 @@ set(CMAKE_CXX_STANDARD 20)
 set(CMAKE_CXX_STANDARD_REQUIRED ON)
 
 add_compile_definitions(JPH_CROSS_PLATFORM_DETERMINISTIC)
+option(ENGINE_PHYSICS_PROFILE "Record Jolt's profiling scopes into engine::profile captures" OFF)
+if(ENGINE_PHYSICS_PROFILE)
+    # Jolt's own profiler and the external profiler are mutually exclusive
+    add_compile_definitions(JPH_EXTERNAL_PROFILE)
+    set(PROFILER_IN_DEBUG_AND_RELEASE OFF)
+endif()
 set(INTERPROCEDURAL_OPTIMIZATION ON)
 include(FetchContent)
 FetchContent_Declare(joltphysics # March 6, 2023
@@ -9,9 +9,11 @@
 
 #include <engine/audio/audio.hpp>
 #include <engine/input/input.hpp>
+#include <engine/jobs/jobs.hpp>
 #include <engine/physics/physics.hpp>
 #include <engine/fs/fs.hpp>
 #include <engine/log/log.hpp>
+#include <engine/profile/profile.hpp>
 #include <engine/strings/strings.hpp>
 #include <engine/graphics/graphics.hpp>
 #include <engine/utils/utils.hpp>
@@ -22,6 +24,10 @@ namespace engine {
 		std::string Title;
 		std::uint32_t Width;
 		std::uint32_t Height;
+		engine::physics::PhysicsOptions Physics{};
+		// The number of times per second that Update is called in headless builds (ENGINE_HEADLESS). Other builds are
+		// paced by the renderer's frame rate.
+		double TickRate = 60.0;
 	};
 
 	class Application {
@@ -33,7 +39,9 @@ namespace engine {
 		Application() noexcept;
 		virtual ~Application();
 
+		// Returns nullptr in headless builds.
 		Rml::Context* GetUIContext() { return rmlContext; }
+		// Returns nullptr in headless builds.
 		engine::audio::Manager* GetAudioManager() { return audioManager.get(); }
 		engine::input::Handler* GetInputHandler() { return inputHandler.get(); }
 		double GetElapsedTime();
@@ -8,8 +8,8 @@
 #define ENGINE_AUDIO_AUDIO_HPP
 
 #include <engine/fs/fs.hpp>
+#include <engine/utils/slotmap.hpp>
 #include <glm/glm.hpp>
-#include <unordered_map>
 
 namespace engine::audio {
 	class Sound {
@@ -64,7 +64,8 @@ namespace engine::audio {
 		glm::vec3 pos;
 	};
 
-	typedef int SoundGroup;
+	// A handle to a sound group. A default constructed SoundGroup refers to the master sound group.
+	typedef engine::utils::SlotHandle SoundGroup;
 
 	class Manager {
 	public:
@@ -78,7 +79,7 @@ namespace engine::audio {
 		// Returns null on error.
 		std::unique_ptr<Sound> LoadMusic(
 			const std::filesystem::path& filePath,
-			SoundGroup soundGroup = 0,
+			SoundGroup soundGroup = {},
 			bool streamFromFile = true,
 			bool loop = true);
 		// LoadSoundEffect loads the given sound effect file.
@@ -89,7 +90,7 @@ namespace engine::audio {
 		// Returns null on error.
 		std::unique_ptr<Sound> LoadSoundEffect(
 			const std::filesystem::path& filePath,
-			SoundGroup soundGroup = 0,
+			SoundGroup soundGroup = {},
 			bool streamFromFile = false,
 			bool loop = false);
 		// LoadPositionalSoundEffect loads the given positional sound effect file.
@@ -100,23 +101,23 @@ namespace engine::audio {
 		// Returns null on error.
 		std::unique_ptr<PositionalSound> LoadPositionalSoundEffect(
 			const std::filesystem::path& filePath,
-			SoundGroup soundGroup = 0,
+			SoundGroup soundGroup = {},
 			bool streamFromFile = false,
 			bool loop = false);
 
 		Listener* GetListener();
 
-		// GetMasterSoundGroup returns the master sound group (0).
+		// GetMasterSoundGroup returns the master sound group.
 		static SoundGroup GetMasterSoundGroup();
 		// CreateSoundGroup will create a sound group with the provided parent sound group.
-		// If no parent sound group is provided, it will default to using the master sound group (0) as parent.
-		SoundGroup CreateSoundGroup(SoundGroup parentGroup = 0);
+		// If no parent sound group is provided, it will default to using the master sound group as parent.
+		SoundGroup CreateSoundGroup(SoundGroup parentGroup = {});
 		// DeleteSoundGroup will delete the provided sound group.
-		// You cannot delete the master sound group (0); no error is returned, just nothing happens.
+		// You cannot delete the master sound group; no error is returned, just nothing happens.
 		void DeleteSoundGroup(SoundGroup soundGroup);
 		// SetVolume sets the volume level of the sound group using a linear scale (0 = 0%, 1 = 100%, >= 1 = amplification).
-		// If no sound group is provided, it will default to the master sound group (0).
-		void SetVolume(float volume, SoundGroup soundGroup = 0);
+		// If no sound group is provided, it will default to the master sound group.
+		void SetVolume(float volume, SoundGroup soundGroup = {});
 
 	private:
 		class privateImpl;
@@ -124,9 +125,9 @@ namespace engine::audio {
 		class soundGroupImpl;
 
 		std::unique_ptr<privateImpl> impl;
-		std::unordered_map<int, soundGroupImpl*> soundGroups;
+		engine::utils::SlotMap<soundGroupImpl> soundGroups;
 		std::unique_ptr<engine::audio::Listener> listener;
-		int nextSoundGroupID = 1; // 0 is taken up by master
+		void* getMaSoundGroup(SoundGroup soundGroup);
 		void deleteSoundGroup(SoundGroup soundGroup);
 		void deleteSoundGroupChildren(SoundGroup soundGroup);
 	};
@@ -11,6 +11,7 @@
 #include <engine/gui/backend.hpp>
 #include <engine/gui/renderer.hpp>
 #include <engine/graphics/manager.hpp>
+#include <chrono>
 
 namespace engine {
 	class Application::PlatformImplementation {
@@ -55,6 +56,8 @@ namespace engine {
 		bool Initialize();
 		bool UpdateLoop();
 		void HandleResize(std::uint32_t width, std::uint32_t height);
+		// Get the number of seconds since the application was created.
+		double GetElapsedTime();
 
 	private:
 		friend class PlatformImplementation;
@@ -66,8 +69,14 @@ namespace engine {
 		friend class Application;
 
 		engine::Application* application;
+#ifdef ENGINE_HEADLESS
+		std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+		// The minimum number of seconds between the start of each update, from the application's tick rate
+		double tickTime = 1.0 / 60.0;
+#else
 		std::unique_ptr<engine::gui::Backend> guiBackend;
 		std::unique_ptr<engine::gui::Renderer> guiRenderer;
+#endif //ENGINE_HEADLESS
 		double lastRecordedTime = 0.0;
 	};
 }
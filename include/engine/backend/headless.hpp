@@ -0,0 +1,24 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifdef ENGINE_HEADLESS
+#ifndef ENGINE_BACKEND_HEADLESS_HPP
+#define ENGINE_BACKEND_HEADLESS_HPP
+
+#include <engine/backend/common.hpp>
+
+// Headless builds have no window, so there are no platform messages to receive
+class engine::Application::PlatformImplementation::PlatformCallbacks {
+public:
+	PlatformCallbacks(engine::Application::CommonImplementation* commonImpl);
+	~PlatformCallbacks();
+};
+
+// Headless builds do not hold any platform state
+struct engine::Application::PlatformImplementation::PlatformData {};
+
+#endif //ENGINE_BACKEND_HEADLESS_HPP
+#endif //ENGINE_HEADLESS
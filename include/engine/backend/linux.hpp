@@ -0,0 +1,66 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#if defined(PLATFORM_LINUX) && !defined(ENGINE_HEADLESS)
+#ifndef ENGINE_BACKEND_LINUX_HPP
+#define ENGINE_BACKEND_LINUX_HPP
+
+#include <engine/backend/common.hpp>
+#include <X11/Xlib.h>
+#include <X11/XKBlib.h>
+#include <X11/Xutil.h>
+#include <string>
+
+// Xlib defines several common words as macros, which collide with our own enums (such as Mouse::CaptureState::None)
+#undef None
+#undef Status
+#undef Bool
+#undef True
+#undef False
+
+class engine::Application::PlatformImplementation::PlatformCallbacks {
+public:
+	PlatformCallbacks(engine::Application::CommonImplementation* commonImpl);
+	~PlatformCallbacks();
+
+	void MessageProc(XEvent& event);
+};
+
+struct engine::Application::PlatformImplementation::PlatformData {
+public:
+	// A gamepad that is read directly from its evdev device, as X does not report gamepads
+	struct gamepadDevice {
+	public:
+		int File = -1;
+		std::string Path;
+		// The range of each axis, indexed by the evdev axis code
+		int AxisMinimum[0x40] = {};
+		int AxisMaximum[0x40] = {};
+		float LeftStick[2] = {0.0f, 0.0f};
+		float RightStick[2] = {0.0f, 0.0f};
+		std::unique_ptr<engine::input::Gamepad::Setter> GamepadSetter;
+	};
+
+	std::uint32_t Width = 0;
+	std::uint32_t Height = 0;
+	engine::input::Mouse::CaptureState LastState = engine::input::Mouse::CaptureState::None;
+	bool ReceivedMouseMove = false;
+	bool QuitRequested = false;
+	double NextGamepadScan = 0.0;
+
+	Display* XDisplay = nullptr;
+	Window WindowHandle = 0;
+	Atom DeleteWindowAtom = 0;
+	XIM InputMethod = nullptr;
+	XIC InputContext = nullptr;
+	Cursor HiddenCursor = 0;
+	gamepadDevice Gamepads[4];
+	std::unique_ptr<engine::input::Mouse::Setter> MouseSetter;
+	std::unique_ptr<engine::input::Keyboard::Setter> KeyboardSetter;
+};
+
+#endif //ENGINE_BACKEND_LINUX_HPP
+#endif //PLATFORM_LINUX && !ENGINE_HEADLESS
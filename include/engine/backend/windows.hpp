@@ -4,7 +4,7 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
-#ifdef PLATFORM_WIN32
+#if defined(PLATFORM_WIN32) && !defined(ENGINE_HEADLESS)
 #ifndef ENGINE_BACKEND_WINDOWS_HPP
 #define ENGINE_BACKEND_WINDOWS_HPP
 #ifndef NOMINMAX
@@ -49,4 +49,4 @@ public:
 };
 
 #endif //ENGINE_BACKEND_WINDOWS_HPP
-#endif //PLATFORM_WIN32
+#endif //PLATFORM_WIN32 && !ENGINE_HEADLESS
@@ -8,6 +8,7 @@
 #define ENGINE_GUI_INTERFACES_HPP
 
 #include <engine/utils/freelist.hpp>
+#include <engine/utils/slotmap.hpp>
 #include <engine/graphics/graphics.hpp>
 #include <RmlUi/Core.h>
 #include <math/mat4.h>
@@ -67,7 +68,8 @@ namespace engine::gui {
 		engine::utils::FreeList<Rml::Vertex, 1024> vertexFreeList;
 		engine::utils::FreeList<int, 1024> indexFreeList;
 		std::vector<RmlCompiledGeometry> frameGeometry;
-		std::vector<RmlCompiledGeometry*> geometryToDelete;
+		engine::utils::SlotMap<RmlCompiledGeometry> compiledGeometry;
+		std::vector<engine::utils::SlotHandle> geometryToDelete;
 		std::vector<filament::Texture*> texturesToDelete;
 		filament::math::mat4f currentTransform = filament::math::mat4f();
 		RenderState currentState{};
@@ -7,10 +7,10 @@
 #ifndef ENGINE_INPUT_INPUT_HPP
 #define ENGINE_INPUT_INPUT_HPP
 
+#include <engine/utils/slotmap.hpp>
 #include <functional>
 #include <memory>
 #include <vector>
-#include <unordered_map>
 
 namespace engine {
 	class Application;
@@ -42,15 +42,17 @@ namespace engine::input {
 
 		struct ID {
 		public:
+			// The top bits hold the device type, followed by the generation and index of the device's slot in the handler.
 			std::uint32_t Raw;
 
 			[[nodiscard]] Type GetType() const;
+			[[nodiscard]] engine::utils::SlotHandle GetHandle() const;
 		};
 
 		typedef std::function<void(ID)> DisconnectCallback;
 
 	public:
-		Device(Handler* handler, Type type, std::uint16_t id);
+		Device(Handler* handler, Type type, engine::utils::SlotHandle handle);
 		virtual ~Device();
 
 		[[nodiscard]] Handler* GetHandler() const;
@@ -127,7 +129,7 @@ namespace engine::input {
 
 		friend class Setter;
 
-		Mouse(Handler* handler, std::uint16_t id);
+		Mouse(Handler* handler, engine::utils::SlotHandle handle);
 
 		struct buttonState {
 			KeyState state;
@@ -289,7 +291,7 @@ namespace engine::input {
 
 		friend class Setter;
 
-		Keyboard(Handler* handler, std::uint16_t id);
+		Keyboard(Handler* handler, engine::utils::SlotHandle handle);
 
 		struct keyState {
 			KeyState state;
@@ -368,7 +370,7 @@ namespace engine::input {
 
 		friend class Setter;
 
-		Gamepad(Handler* handler, std::uint16_t id);
+		Gamepad(Handler* handler, engine::utils::SlotHandle handle);
 
 		struct buttonState {
 			KeyState state;
@@ -414,9 +416,14 @@ namespace engine::input {
 		void Update();
 
 	private:
+		template<typename T>
+		std::shared_ptr<T> getDevice(Device::ID id, Device::Type type);
+		template<typename T>
+		std::unique_ptr<typename T::Setter> connectDevice();
+
 		engine::Application* application;
-		std::vector<std::shared_ptr<Device>> devices;
-		std::uint16_t nextId = 0;
+		// Only 12 bits of the generation fit into a device's ID
+		engine::utils::SlotMap<std::shared_ptr<Device>, 12> devices;
 		Mouse::CaptureState mouseCaptureState = Mouse::CaptureState::None;
 	};
 }
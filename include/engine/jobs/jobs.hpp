@@ -0,0 +1,71 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ENGINE_JOBS_JOBS_HPP
+#define ENGINE_JOBS_JOBS_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+namespace engine::jobs {
+	// Determines the order in which queued jobs are run. Queued jobs of a higher priority are always run before those of
+	// a lower priority, so work that may be delayed (such as decoding assets) should use a lower priority than work
+	// that the current frame is waiting on (such as physics).
+	enum class Priority : std::uint8_t {
+		High,
+		Normal,
+		Low,
+	};
+
+	// The number of priorities.
+	static constexpr std::size_t PriorityCount = 3;
+
+	typedef std::function<void()> JobFunction;
+
+	// Tracks the completion of a set of jobs. A group must outlive all of the jobs that were submitted with it, and may
+	// be reused once all of its jobs have finished.
+	class Group {
+	public:
+		Group() = default;
+		Group(const Group&) = delete;
+		Group& operator=(const Group&) = delete;
+
+		// Returns whether every job in the group has finished.
+		[[nodiscard]] bool IsDone() const { return remaining.load(std::memory_order_acquire) == 0; }
+
+	private:
+		friend class Manager;
+
+		std::atomic<std::uint32_t> remaining{0};
+		// The lowest priority that a job has been submitted to the group with
+		std::atomic<std::uint8_t> lowestPriority{0};
+		// Guards waiters and submissions, and is held while the final job finishes
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::uint32_t waiters = 0;
+		// Incremented for each job that is submitted while a thread is blocked on the group, which wakes it to help
+		std::uint32_t submissions = 0;
+	};
+
+	// Queues a job to be run on a worker thread. When a group is given, the job is tracked by that group. Jobs that are
+	// submitted from a worker are queued on that worker, and are taken by other workers once they run out of work.
+	void Submit(JobFunction job, Priority priority = Priority::Normal, Group* group = nullptr);
+	// Blocks until every job in the group has finished. While it waits, the calling thread runs queued jobs that are at
+	// least as high a priority as the group's lowest priority job, so it's safe to wait from within a job. Once there
+	// are no such jobs left to run, the calling thread sleeps until the group finishes or is given another job.
+	void Wait(Group& group);
+	// Calls the function over the range [0, count), split into batches of at least minBatchSize that are spread across
+	// the workers, and waits for every batch to finish. The calling thread runs the first batch.
+	void ParallelFor(std::size_t count, std::size_t minBatchSize, const std::function<void(std::size_t begin, std::size_t end)>& function, Priority priority = Priority::Normal);
+	// Get the number of worker threads. This does not include the threads that submit or wait on jobs.
+	std::uint32_t GetWorkerCount();
+}
+
+#endif //ENGINE_JOBS_JOBS_HPP
@@ -0,0 +1,79 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ENGINE_JOBS_MANAGER_HPP
+#define ENGINE_JOBS_MANAGER_HPP
+
+#include <engine/jobs/jobs.hpp>
+#include <engine/utils/queue.hpp>
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace engine::jobs {
+	// Initialize the job system. When the worker count is zero, a worker is created for every hardware thread other
+	// than the main thread. Called internally by the engine.
+	void Initialize(std::uint32_t workerCount = 0);
+	// Terminates the job system, waiting for all running jobs to finish. Called internally by the engine.
+	void Terminate();
+
+	class Manager {
+	public:
+		Manager(std::uint32_t workerCount);
+		~Manager();
+
+		void Submit(JobFunction job, Priority priority, Group* group);
+		void Wait(Group& group);
+		void ParallelFor(std::size_t count, std::size_t minBatchSize, const std::function<void(std::size_t begin, std::size_t end)>& function, Priority priority);
+		[[nodiscard]] std::uint32_t GetWorkerCount() const;
+
+	private:
+		struct job {
+		public:
+			JobFunction Function;
+			Group* JobGroup = nullptr;
+		};
+
+		// Holds a deque for each priority. The owning worker pushes and pops jobs from the back, so that it works on
+		// the jobs that are most likely to still be in its cache, while other threads steal from the front.
+		struct alignas(engine::utils::CacheLineSize) workQueue {
+		public:
+			std::mutex Mutex;
+			std::array<std::deque<job>, PriorityCount> Jobs;
+			// Lets other threads skip the queue without taking the lock when it's empty
+			std::atomic<std::uint32_t> Count{0};
+		};
+
+		// Identifies threads that are not workers, such as the main thread.
+		static constexpr std::uint32_t noWorker = 0xFFFFFFFF;
+		// The number of times that a waiting thread yields without finding a job before it sleeps.
+		static constexpr std::uint32_t waitSpinCount = 64;
+
+		void workerLoop(std::uint32_t workerIndex);
+		// Runs a single queued job of at most the given priority, returning false if there were no jobs to run.
+		bool tryRunJob(std::uint32_t workerIndex, std::size_t lowestPriority = PriorityCount - 1);
+		bool popJob(std::uint32_t workerIndex, std::size_t lowestPriority, job& result);
+		void finishJob(Group& group);
+		bool popFromQueue(workQueue& queue, std::size_t priority, bool fromBack, job& result);
+
+		std::vector<std::thread> workers;
+		// The first queue of each worker is its own, while the final queue receives jobs from threads outside the pool
+		std::vector<std::unique_ptr<workQueue>> queues;
+		std::atomic<std::uint32_t> queuedJobs{0};
+		std::atomic<std::uint32_t> sleepingWorkers{0};
+		std::mutex sleepMutex;
+		std::condition_variable sleepCondition;
+		std::atomic<bool> stopping{false};
+	};
+
+	extern Manager* GlobalManager;
+}
+
+#endif //ENGINE_JOBS_MANAGER_HPP
@@ -8,21 +8,33 @@
 #define ENGINE_PHYSICS_MANAGER_HPP
 
 #include <engine/application.hpp>
+#include <engine/jobs/jobs.hpp>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
 
 // Must include "Jolt.h" before including any other Jolt header.
 #include <Jolt/Jolt.h>
 #include <Jolt/RegisterTypes.h>
 #include <Jolt/Core/Factory.h>
 #include <Jolt/Core/TempAllocator.h>
-#include <Jolt/Core/JobSystemThreadPool.h>
+#include <Jolt/Core/JobSystemWithBarrier.h>
+#include <Jolt/Core/FixedSizeFreeList.h>
 #include <Jolt/Physics/PhysicsSettings.h>
 #include <Jolt/Physics/PhysicsSystem.h>
+#include <Jolt/Physics/StateRecorder.h>
 #include <Jolt/Physics/Body/BodyCreationSettings.h>
 #include <Jolt/Physics/Body/BodyActivationListener.h>
 #include <Jolt/Physics/Collision/CastResult.h>
 #include <Jolt/Physics/Collision/CollisionCollectorImpl.h>
 #include <Jolt/Physics/Collision/RayCast.h>
 #include <Jolt/Physics/Character/Character.h>
+#include <Jolt/Physics/Character/CharacterVirtual.h>
 
 namespace engine::physics {
 	// Initialize the physics engine. Called internally by the engine.
@@ -31,25 +43,73 @@ namespace engine::physics {
 	void Update(double deltaTime);
 	// Terminates the physics engine. Called internally by the engine.
 	void Terminate();
+	// Get the world that the free functions operate on for the calling thread. This is the global world unless another
+	// world has been made current.
+	Manager* GetCurrentManager();
+	// Set the world that the free functions operate on for the calling thread, returning the previous world. Setting a
+	// nullptr restores the global world.
+	Manager* SetCurrentManager(Manager* manager);
+
+	// Runs Jolt's jobs on the engine's job system, so that physics shares its workers with the rest of the engine rather
+	// than creating its own threads. Barriers are provided by Jolt, and waiting on a barrier runs its jobs on the
+	// waiting thread.
+	class JobSystemImpl final : public JPH::JobSystemWithBarrier {
+	public:
+		JobSystemImpl(JPH::uint maxJobs, JPH::uint maxBarriers);
+		[[nodiscard]] int GetMaxConcurrency() const override;
+		JobHandle CreateJob(const char* inName, JPH::ColorArg inColor, const JobFunction& inJobFunction, JPH::uint32 inNumDependencies = 0) override;
 
-	// Layers that objects can be in, which determines the other objects it can collide with.
-	namespace Layers {
-		static constexpr JPH::uint8 NON_MOVING = 0;
-		static constexpr JPH::uint8 MOVING = 1;
-		static constexpr JPH::uint8 NUM_LAYERS = 2;
-	}
+	protected:
+		void QueueJob(Job* inJob) override;
+		void QueueJobs(Job** inJobs, JPH::uint inNumJobs) override;
+		void FreeJob(Job* inJob) override;
 
-	// Each broad phase layer results in a separate bounding volume tree in the broad phase. Having a layer for
-	// non-moving and another for moving objects avoids having to update a tree full of static objects every frame.
-	namespace BroadPhaseLayers {
-		static constexpr JPH::BroadPhaseLayer NONMOVING(0);
-		static constexpr JPH::BroadPhaseLayer MOVING(1);
-		static constexpr JPH::uint NUM_LAYERS(2);
-	}
+	private:
+		JPH::FixedSizeFreeList<Job> jobs;
+	};
+
+	// A stack allocator for the temporary allocations made during a step. Once a block is full, another block is added
+	// when growing, or the allocation falls back to the heap when not. Blocks are kept once added, so a world's peak
+	// usage is only paid for once.
+	class GrowingTempAllocator final : public JPH::TempAllocator {
+	public:
+		GrowingTempAllocator(std::size_t blockSize, bool grow);
+		~GrowingTempAllocator() override;
+		void* Allocate(JPH::uint inSize) override;
+		void Free(void* inAddress, JPH::uint inSize) override;
+
+		[[nodiscard]] std::size_t GetHighWaterMark() const;
+		[[nodiscard]] std::size_t GetCapacity() const;
+		[[nodiscard]] std::uint32_t GetOverflowCount() const;
+		// Resets the high-water mark to the memory that is currently in use.
+		void ResetHighWaterMark();
+		// Returns the most memory in use at once since the previous call, and begins measuring again from the memory that
+		// is currently in use. Only called between steps.
+		std::size_t TakeStepHighWaterMark();
+
+	private:
+		struct block {
+		public:
+			std::uint8_t* Data;
+			std::size_t Size;
+			std::size_t Top;
+		};
+
+		std::vector<block> blocks;
+		std::size_t currentBlock = 0;
+		std::size_t blockSize;
+		bool grow;
+		std::size_t used = 0;
+		std::size_t stepHighWaterMark = 0;
+		// Read from other threads while a step is running
+		std::atomic<std::size_t> highWaterMark{0};
+		std::atomic<std::size_t> capacity{0};
+		std::atomic<std::uint32_t> overflowCount{0};
+	};
 
 	class BroadPhaseLayerImpl final : public JPH::BroadPhaseLayerInterface {
 	public:
-		BroadPhaseLayerImpl();
+		BroadPhaseLayerImpl(const LayerConfiguration& configuration);
 		[[nodiscard]] JPH::uint GetNumBroadPhaseLayers() const override;
 		[[nodiscard]] JPH::BroadPhaseLayer GetBroadPhaseLayer(JPH::ObjectLayer layer) const override;
 
@@ -58,41 +118,162 @@ namespace engine::physics {
 #endif // JPH_EXTERNAL_PROFILE || JPH_PROFILE_ENABLED
 
 	private:
-		JPH::BroadPhaseLayer objToBP[Layers::NUM_LAYERS] = {BroadPhaseLayers::NONMOVING, BroadPhaseLayers::MOVING};
+		std::uint32_t layerCount;
+		std::uint32_t broadPhaseLayerCount;
+		std::array<JPH::BroadPhaseLayer, MaxLayers> objToBP;
+#if defined(JPH_EXTERNAL_PROFILE) || defined(JPH_PROFILE_ENABLED)
+		std::array<std::string, MaxLayers> broadPhaseLayerNames;
+#endif // JPH_EXTERNAL_PROFILE || JPH_PROFILE_ENABLED
 	};
 
 	class ObjectVsBroadPhaseLayerFilterImpl final : public JPH::ObjectVsBroadPhaseLayerFilter {
+	public:
+		ObjectVsBroadPhaseLayerFilterImpl(const LayerConfiguration& configuration);
 		[[nodiscard]] bool ShouldCollide(JPH::ObjectLayer inLayer1, JPH::BroadPhaseLayer inLayer2) const override;
+
+	private:
+		// Bit N of broadPhaseMasks[M] determines whether object layer M collides with anything in broad phase layer N
+		std::array<LayerMask, MaxLayers> broadPhaseMasks{};
 	};
 
 	class ObjectLayerPairFilterImpl final : public JPH::ObjectLayerPairFilter {
+	public:
+		ObjectLayerPairFilterImpl(const LayerConfiguration& configuration);
 		[[nodiscard]] bool ShouldCollide(JPH::ObjectLayer inLayer1, JPH::ObjectLayer inLayer2) const override;
+
+	private:
+		// A symmetric version of the configuration's collision masks
+		std::array<LayerMask, MaxLayers> collisionMasks{};
+	};
+
+	// Accepts only the object layers that are within the mask.
+	class LayerMaskFilter final : public JPH::ObjectLayerFilter {
+	public:
+		LayerMaskFilter(LayerMask layers);
+		[[nodiscard]] bool ShouldCollide(JPH::ObjectLayer layer) const override;
+
+	private:
+		LayerMask layers;
+	};
+
+	// Writes Jolt's binary data directly into a byte vector, which lets the vector reuse its allocation between writes,
+	// or reads it back from a span of bytes. Used for both physics states and cooked shapes.
+	class ByteStateRecorder final : public JPH::StateRecorder {
+	public:
+		ByteStateRecorder(std::vector<std::uint8_t>& output);
+		ByteStateRecorder(std::span<const std::uint8_t> input);
+		void WriteBytes(const void* inData, size_t inNumBytes) override;
+		void ReadBytes(void* outData, size_t inNumBytes) override;
+		[[nodiscard]] bool IsEOF() const override;
+		[[nodiscard]] bool IsFailed() const override;
+
+	private:
+		std::vector<std::uint8_t>* output = nullptr;
+		std::span<const std::uint8_t> input;
+		size_t readPosition = 0;
+		bool failed = false;
 	};
 
+	// Records contact events into a preallocated array. Jolt calls the listener from its job threads, so each event
+	// claims a slot with an atomic cursor rather than taking a lock, and the events are sorted once the step is done.
 	class InternalContactListener : public JPH::ContactListener {
 	public:
+		// A contact between a sensor and another body that was added or removed. These are recorded separately from
+		// the contact events, so that sensor overlaps are not affected by the contact event limit.
+		struct SensorChange {
+		public:
+			ContactEventType Type;
+			std::uint32_t SensorID;
+			std::uint32_t OtherID;
+		};
+
+		InternalContactListener(Manager* manager, std::uint32_t capacity);
 		JPH::ValidateResult OnContactValidate(const JPH::Body& inBody1, const JPH::Body& inBody2, JPH::RVec3Arg inBaseOffset, const JPH::CollideShapeResult& inCollisionResult) override;
 		void OnContactAdded(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold, JPH::ContactSettings& ioSettings) override;
 		void OnContactPersisted(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold, JPH::ContactSettings& ioSettings) override;
 		void OnContactRemoved(const JPH::SubShapeIDPair& inSubShapePair) override;
+
+		// Discards all recorded events. Must not be called during a physics step.
+		void Reset();
+		// Sorts the events recorded since the last reset. Must not be called during a physics step.
+		void Finalize();
+		// Get the events that were sorted by the last call to Finalize.
+		[[nodiscard]] std::span<const ContactEvent> GetEvents() const;
+		// Returns the number of non-sensor contact manifolds that were added or persisted since the last call, which is
+		// the number of contact constraints in the step that was just simulated.
+		std::uint32_t TakeContactCount();
+		// Get the largest number of events that were recorded between a reset and a finalize, including dropped events.
+		[[nodiscard]] std::uint32_t GetPeakEventCount() const;
+		void ResetPeakEventCount();
+		// Get the sensor contacts that were added or removed since the last clear. Must not be called during a physics
+		// step.
+		[[nodiscard]] std::span<const SensorChange> GetSensorChanges() const;
+		// Must not be called during a physics step.
+		void ClearSensorChanges();
+
+	private:
+		void record(ContactEventType type, const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold);
+
+		Manager* manager;
+		std::vector<ContactEvent> events;
+		std::atomic<std::uint32_t> cursor{0};
+		std::atomic<std::uint32_t> contactCount{0};
+		std::uint32_t eventCount = 0;
+		std::atomic<std::uint32_t> peakEventCount{0};
+		// Sensor contacts are rare compared to other contacts, so a lock is cheap enough
+		std::mutex sensorMutex;
+		std::vector<SensorChange> sensorChanges;
 	};
 
 	class Manager {
 	public:
-		Manager(engine::Application* application);
+		Manager(engine::Application* application, const PhysicsOptions& options);
 		~Manager();
 		void Enable();
 		void Disable();
 		void Update(double deltaTime);
 		void SetUpdateRate(double rate);
+		void SetMaxSubsteps(std::uint32_t maxSubsteps);
+		// Set the function that is called before every step, in place of the application's FixedUpdate.
+		void SetFixedUpdate(std::function<void(double)> function);
+		double GetInterpolationAlpha();
 		void OptimizeBroadPhase();
 
 		glm::vec3 GetGravity();
 		void SetGravity(glm::vec3 gravity);
-		std::vector<RayResult> CastRay(glm::vec3 origin, glm::vec3 direction, RayFilter filter);
+		std::vector<RayResult> CastRay(glm::vec3 origin, glm::vec3 direction, RayFilter filter, LayerMask layers);
+		void CastRays(std::span<const Ray> rays, RayFilter filter, std::span<RayResult> results, LayerMask layers);
+		std::vector<ShapeCastResult> CastSphere(glm::vec3 origin, float radius, glm::vec3 directionWithMagnitude, RayFilter filter, LayerMask layers);
+		std::vector<ShapeCastResult> CastCapsule(glm::vec3 origin, glm::quat rotation, float height, float radius, glm::vec3 directionWithMagnitude, RayFilter filter, LayerMask layers);
+		std::vector<Body> OverlapSphere(glm::vec3 center, float radius, LayerMask layers);
+		std::vector<Body> OverlapBox(glm::vec3 center, glm::quat rotation, glm::vec3 size, LayerMask layers);
+		std::vector<Body> OverlapCapsule(glm::vec3 center, glm::quat rotation, float height, float radius, LayerMask layers);
+		std::span<const ContactEvent> GetContactEvents();
+		std::span<const SensorEvent> GetSensorEvents();
+		std::span<const Body> GetSensorOverlaps(const Body& sensor);
+		void ReadTransforms(std::span<const Body> bodies, std::span<glm::vec3> positions, std::span<glm::quat> rotations);
+		std::size_t ReadActiveTransforms(std::span<std::uint32_t> ids, std::span<glm::vec3> positions, std::span<glm::quat> rotations);
+		void ReadInterpolatedTransforms(std::span<const Body> bodies, std::span<glm::vec3> positions, std::span<glm::quat> rotations);
+		std::uint32_t GetNumberOfActiveBodies();
+		void Synchronize();
+		void QueueForce(const Body& body, glm::vec3 force);
+		void QueueImpulse(const Body& body, glm::vec3 impulse);
+		void QueueTeleport(const Body& body, glm::vec3 position, glm::quat rotation);
+		void SubmitCommands(CommandBuffer& buffer);
+		void QueueSpawn(const BatchBodyCreationProperties& properties);
+		std::span<const Body> GetSpawnedBodies();
+		void SaveState(PhysicsState& state);
+		bool RestoreState(const PhysicsState& state);
+		std::uint32_t GetMaxNumberOfBodies();
+		PhysicsCounters GetCounters();
+		void ResetPeakCounters();
+		std::span<const std::uint64_t> GetStepHashes();
+		std::span<const PhysicsStepStats> GetStepStats();
+		std::uint64_t HashState();
+		DeterminismResult VerifyDeterminism(std::uint32_t steps, std::uint32_t runs);
 
 		// Returns a new Body defined by the given shape. Will return a nullptr once the max body count has been reached.
-		std::unique_ptr<Body> CreateBody(JPH::Shape* shape, BodyCreationProperties properties);
+		std::unique_ptr<Body> CreateBody(const JPH::Shape* shape, BodyCreationProperties properties);
 		// Returns a new sphere. Will return a nullptr once the max body count has been reached.
 		std::unique_ptr<Body> CreateSphere(float radius, BodyCreationProperties properties);
 		// Returns a new box. Will return a nullptr once the max body count has been reached.
@@ -104,24 +285,213 @@ namespace engine::physics {
 		// Returns a new cylinder. Will return a nullptr once the max body count has been reached.
 		std::unique_ptr<Body> CreateCylinder(float height, float radius, BodyCreationProperties properties);
 
+		bool CookMesh(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, std::span<const glm::vec3> vertices, std::span<const std::uint32_t> indices);
+		bool CookHeightField(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, std::span<const float> heights, std::uint32_t sampleCount, glm::vec3 offset, glm::vec3 scale);
+		bool CookCompound(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, std::span<const CompoundChild> children, Mass mass);
+		// Returns a new body from a cooked mesh. Will return a nullptr if the file could not be loaded, or once the max
+		// body count has been reached.
+		std::unique_ptr<Body> CreateMesh(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, BodyCreationProperties properties);
+		// Returns a new body from a cooked height field. Will return a nullptr if the file could not be loaded, or once
+		// the max body count has been reached.
+		std::unique_ptr<Body> CreateHeightField(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, BodyCreationProperties properties);
+		// Returns a new body from a cooked compound. Will return a nullptr if the file could not be loaded, or once the
+		// max body count has been reached.
+		std::unique_ptr<Body> CreateCompound(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, BodyCreationProperties properties);
+
+		// Creates all of the given bodies and inserts them into the broad phase as a single batch, optionally followed by
+		// a full broad phase optimization.
+		std::vector<Body> CreateBodies(std::span<const BatchBodyCreationProperties> properties, bool optimizeBroadPhase = true);
+		// Removes and destroys all of the given bodies as a single batch.
+		void DestroyBodies(std::span<const Body> bodies);
+		// Releases cached shapes that are no longer used by any body.
+		void ClearUnusedShapes();
+
 		// Returns a new character. Will return a nullptr once the max body count has been reached.
 		std::unique_ptr<Character> CreateCharacter(CharacterCreationProperties properties);
+		// Returns a new virtual character.
+		std::unique_ptr<VirtualCharacter> CreateVirtualCharacter(CharacterCreationProperties properties);
+		// Moves all of the given characters in parallel.
+		void UpdateCharacters(std::span<VirtualCharacter* const> characters, float deltaTime);
 	private:
 		friend class Body;
-
-		std::unique_ptr<JPH::JobSystemThreadPool> jobSystem;
+		friend class InternalContactListener;
+
+		// Identifies a shape by everything that contributes to its construction, so that identical shapes are shared.
+		struct shapeKey {
+		public:
+			Shape Type;
+			float Dimensions[3] = {0.0f, 0.0f, 0.0f};
+			float Density = 0.0f;
+			float Weight = 0.0f;
+
+			bool operator==(const shapeKey& other) const = default;
+		};
+		struct shapeKeyHash {
+		public:
+			std::size_t operator()(const shapeKey& key) const;
+		};
+
+		// A shape that was loaded from a cooked file, along with the type that it was cooked as.
+		struct cookedShape {
+		public:
+			Shape Type;
+			JPH::ShapeRefC Collider;
+		};
+
+		// The transform of a body from before the most recent step that it was active in.
+		struct previousTransform {
+		public:
+			JPH::Vec3 Position;
+			JPH::Quat Rotation;
+			// The step that followed this transform, so stale transforms from sleeping bodies are ignored
+			std::uint64_t Step = 0;
+		};
+
+		// The contacts between a sensor and another body, counted across their sub shapes.
+		struct sensorContact {
+		public:
+			std::uint32_t Count = 0;
+			std::uint32_t SensorID;
+			std::uint32_t OtherID;
+		};
+
+		// The transform of a body at the end of a frame's simulation, as seen by the main thread while the physics
+		// thread simulates the next frame.
+		struct snapshotTransform {
+		public:
+			JPH::BodyID BodyID;
+			JPH::Vec3 Position;
+			JPH::Quat Rotation;
+			JPH::Vec3 PreviousPosition;
+			JPH::Quat PreviousRotation;
+		};
+
+		// Simulates the given amount of time according to the step mode.
+		void simulate(double deltaTime);
+		// Simulates a single step of the given length.
+		void step(double deltaTime);
+		// Applies all queued commands and spawns. Must not be called during a step.
+		void applyCommands();
+		// Runs on the physics thread, simulating each frame as it is requested.
+		void physicsThreadLoop();
+		// Blocks until the physics thread has finished simulating the requested frame.
+		void waitForStep();
+		// Copies the transforms of all active bodies into the back snapshot.
+		void captureSnapshot();
+		// Captures the bodies that were created or moved since the last frame into both snapshots. Must not be called
+		// during a step.
+		void captureUncapturedBodies();
+		// Finds the snapshot of the given body, returning nullptr if it has not been captured.
+		const snapshotTransform* getSnapshot(JPH::BodyID bodyID) const;
+		// Records the transforms of all active bodies before the last step of a frame.
+		void recordPreviousTransforms();
+		// Updates the sensor overlaps from the sensor contacts of the most recent step, recording when they change. This
+		// is called after every step, so that the contacts removed by a step are always found in sensorContacts.
+		void updateSensors();
+		// Returns the key of a pair of bodies in sensorContacts.
+		static std::uint64_t sensorPairKey(std::uint32_t idA, std::uint32_t idB);
+		RayResult castSingleRay(const Ray& ray, RayFilter filter, LayerMask layers);
+		std::vector<ShapeCastResult> castShape(const JPH::Shape* shape, glm::mat4 transform, glm::vec3 directionWithMagnitude, RayFilter filter, LayerMask layers);
+		std::vector<Body> overlapShape(const JPH::Shape* shape, glm::mat4 transform, LayerMask layers);
+		// Get the surface normal at the point and the user data of the body, which are read under a single lock
+		glm::vec3 getSurfaceNormal(JPH::BodyID bodyID, const JPH::SubShapeID& subShapeID, glm::vec3 point, std::uint64_t& userData);
+		bool getCreationSettings(const JPH::Shape* shape, const BodyCreationProperties& properties, JPH::BodyCreationSettings& settings);
+		// Returns a shared shape matching the given properties, creating it if it is not already cached.
+		JPH::ShapeRefC createShape(const ShapeProperties& shape, Mass mass);
+		JPH::ShapeRefC createSphereShape(float radius, Mass mass);
+		JPH::ShapeRefC createBoxShape(glm::vec3 boxShape, Mass mass);
+		JPH::ShapeRefC createCapsuleShape(float height, float radius, Mass mass);
+		JPH::ShapeRefC createTaperedCapsuleShape(float height, float topRadius, float bottomRadius, Mass mass);
+		JPH::ShapeRefC createCylinderShape(float height, float radius, Mass mass);
+		// Returns a capsule that stands on the origin, which is shared by both kinds of character.
+		JPH::ShapeRefC createCharacterShape(const CharacterCreationProperties& properties);
+		// Writes the given shape and all of its children to a cooked file.
+		bool saveCookedShape(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, Shape type, const JPH::Shape* shape);
+		// Returns the cooked shape at the given path, loading it if it is not already cached. Returns nullptr if the
+		// file could not be loaded, or if it holds a different type of shape.
+		JPH::ShapeRefC loadCookedShape(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, Shape type);
+		std::unique_ptr<Body> createCookedBody(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, Shape type, BodyCreationProperties properties);
+
+		std::unique_ptr<JobSystemImpl> jobSystem;
 		std::unique_ptr<BroadPhaseLayerImpl> broadPhaseLayerImpl;
 		std::unique_ptr<ObjectVsBroadPhaseLayerFilterImpl> objectVsBroadPhaseLayerFilterImpl;
 		std::unique_ptr<ObjectLayerPairFilterImpl> objectLayerPairFilterImpl;
-		std::unique_ptr<JPH::TempAllocatorImpl> tempAllocator;
+		std::unique_ptr<GrowingTempAllocator> tempAllocator;
 		std::unique_ptr<JPH::PhysicsSystem> physicsSystem;
-		std::unique_ptr<InternalContactListener> contactListener; //TODO: add a Set function for the new contact listener
+		std::unique_ptr<InternalContactListener> contactListener;
+		// The application is only set for the global world, as other worlds call their own fixed update
 		engine::Application* application;
+		std::function<void(double)> fixedUpdate;
+		std::uint32_t layerCount;
+		// Reused by ReadActiveTransforms so that reading the active bodies does not allocate every frame
+		JPH::BodyIDVector activeBodies;
+		std::unordered_map<shapeKey, JPH::ShapeRefC, shapeKeyHash> shapeCache;
+		// Keyed by the generic form of the cooked file's path
+		std::unordered_map<std::string, cookedShape> cookedShapeCache;
 
 		// 60Hz is the default rate for physics calculations.
 		double maxDeltaTimeStep = 1.0 / 60.0;
 		float maxDeltaTimeStepf = (float)maxDeltaTimeStep;
-		bool enabled = true;
+		StepMode stepMode;
+		std::uint32_t maxSubsteps;
+		// Time that has passed but has not been simulated yet, which is always less than a single step
+		double accumulatedTime = 0.0;
+		double interpolationAlpha = 1.0;
+		// The number of steps that have been simulated, which starts at 1 so that no recorded transform matches
+		std::uint64_t stepCount = 1;
+		std::uint32_t maxContactConstraints;
+		std::uint32_t maxContactEvents;
+		// Read by GetCounters while a step may be running on the physics thread
+		std::atomic<std::uint32_t> lastContactManifolds{0};
+		std::atomic<std::uint32_t> peakContactManifolds{0};
+		// Indexed by the body's index, and only allocated once the first transforms are recorded
+		std::vector<previousTransform> previousTransforms;
+		// Keyed by the IDs of both bodies, with the smaller ID in the upper half
+		std::unordered_map<std::uint64_t, sensorContact> sensorContacts;
+		// Keyed by the sensor's ID, only holding sensors that are overlapped by at least one body
+		std::unordered_map<std::uint32_t, std::vector<Body>> sensorOverlaps;
+		std::vector<SensorEvent> sensorEvents;
+		// Reused between steps to sort the listener's sensor changes
+		std::vector<InternalContactListener::SensorChange> sensorChangeOrder;
+		bool deterministic;
+		std::vector<std::uint64_t> stepHashes;
+		std::vector<PhysicsStepStats> stepStats;
+		// Reused by HashState so that hashing every step does not allocate
+		JPH::BodyIDVector hashedBodies;
+
+		// Commands may be queued from any thread, so they're guarded by their own mutex
+		std::mutex commandMutex;
+		CommandBuffer queuedCommands;
+		std::vector<BatchBodyCreationProperties> queuedSpawns;
+		// Swapped with the queues while applying so that the lock is not held while the commands are applied
+		CommandBuffer applyingCommands;
+		std::vector<BatchBodyCreationProperties> applyingSpawns;
+		std::vector<Body> spawnedBodies;
+		// Reused by applyCommands so that activating the commanded bodies does not allocate every frame
+		JPH::BodyIDVector activatingBodies;
+
+		bool asynchronous;
+		std::thread physicsThread;
+		// Guards the fields that hand frames between the main thread and the physics thread
+		std::mutex stepMutex;
+		std::condition_variable stepCondition;
+		double requestedDeltaTime = 0.0;
+		bool stepRequested = false;
+		bool stopping = false;
+		// The snapshot at frontSnapshot is read by the main thread, while the physics thread writes the other one. The
+		// bodies captured into each snapshot are kept so that bodies which fall asleep are captured into both.
+		std::array<std::vector<snapshotTransform>, 2> snapshots;
+		std::array<JPH::BodyIDVector, 2> snapshotBodies;
+		// Bodies that were created or moved between frames. Sleeping bodies are never captured by the physics thread, so
+		// these are captured into both snapshots before the next frame is handed off.
+		JPH::BodyIDVector uncapturedBodies;
+		std::uint32_t frontSnapshot = 0;
+		double publishedInterpolationAlpha = 1.0;
+		std::vector<ContactEvent> publishedContactEvents;
+		std::vector<SensorEvent> publishedSensorEvents;
+		std::vector<std::uint64_t> publishedStepHashes;
+		std::vector<PhysicsStepStats> publishedStepStats;
+		std::atomic<bool> enabled{true};
 	};
 
 	extern Manager* GlobalManager;
@@ -169,6 +539,13 @@ inline engine::physics::Shape toGLM(JPH::EShapeSubType shape) {
 			return engine::physics::Shape::TaperedCapsule;
 		case JPH::EShapeSubType::Cylinder:
 			return engine::physics::Shape::Cylinder;
+		case JPH::EShapeSubType::Mesh:
+			return engine::physics::Shape::Mesh;
+		case JPH::EShapeSubType::HeightField:
+			return engine::physics::Shape::HeightField;
+		case JPH::EShapeSubType::StaticCompound:
+		case JPH::EShapeSubType::MutableCompound:
+			return engine::physics::Shape::Compound;
 		default:
 			engine::log::Fatal("Additional physics Shape that has not been accounted for");
 			return engine::physics::Shape::Capsule;
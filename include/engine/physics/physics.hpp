@@ -7,7 +7,14 @@
 #ifndef ENGINE_PHYSICS_PHYSICS_HPP
 #define ENGINE_PHYSICS_PHYSICS_HPP
 
+#include <array>
+#include <filesystem>
+#include <functional>
 #include <memory>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
 #include <glm/glm.hpp>
 #include <glm/gtx/quaternion.hpp>
 #include <glm/gtc/quaternion.hpp>
@@ -16,6 +23,14 @@ namespace engine {
 	class Application;
 }
 
+namespace engine::fs {
+	class IFileSystem;
+}
+
+namespace engine::jobs {
+	class Group;
+}
+
 namespace engine::physics {
 	class Manager;
 
@@ -76,6 +91,91 @@ namespace engine::physics {
 		Airborne,
 	};
 
+	// An object layer, which determines the other layers that a body may collide with.
+	typedef std::uint8_t Layer;
+
+	// The layers that bodies are placed in when a layer is not specified.
+	namespace Layers {
+		static constexpr Layer NON_MOVING = 0;
+		static constexpr Layer MOVING = 1;
+	}
+
+	// The maximum number of object layers, and also the maximum number of broad phase layers.
+	static constexpr std::uint32_t MaxLayers = 32;
+
+	// A set of object layers, where each bit represents the layer of the same index. Queries only consider bodies
+	// whose layer is within the mask.
+	typedef std::uint32_t LayerMask;
+	// A mask that contains every layer.
+	static constexpr LayerMask AllLayers = 0xFFFFFFFF;
+
+	// Defines the object layers, which layers collide with each other, and how they're grouped in the broad phase. The
+	// defaults match the built-in layers, where NON_MOVING only collides with MOVING, and MOVING collides with
+	// everything. Layers NON_MOVING and MOVING must always exist, as they're used when a body does not specify a layer.
+	struct LayerConfiguration {
+	public:
+		// The number of object layers in use, which must be between 2 and MaxLayers.
+		std::uint32_t LayerCount = 2;
+		// Bit N of CollisionMasks[M] determines whether layer M collides with layer N. If either of the two layers
+		// says that they collide, then they collide.
+		std::array<LayerMask, MaxLayers> CollisionMasks = {0b10, 0b11};
+		// The number of broad phase layers in use, which must be between 1 and MaxLayers. Each broad phase layer is a
+		// separate bounding volume tree, so layers that rarely move or rarely collide should be kept apart from the rest.
+		std::uint32_t BroadPhaseLayerCount = 2;
+		// BroadPhaseLayers[N] is the broad phase layer that object layer N belongs to.
+		std::array<std::uint8_t, MaxLayers> BroadPhaseLayers = {0, 1};
+	};
+
+	// Determines how the time between frames is divided into physics steps.
+	enum class StepMode : std::uint8_t {
+		// Only full steps at the update rate are simulated, and any leftover time is carried over to the next frame.
+		// Every step has the same length, so the simulation is reproducible and does not depend on the frame rate. As
+		// the simulation lags behind the frame by up to a single step, rendering should interpolate between the last
+		// two steps using ReadInterpolatedTransforms.
+		Accumulate,
+		// Full steps at the update rate are simulated, followed by a shorter step for any leftover time, so that the
+		// simulation always matches the frame. The length of the last step changes every frame.
+		Remainder,
+	};
+
+	// The set of parameters that govern the physics engine. These cannot be changed after the engine is initialized.
+	struct PhysicsOptions {
+	public:
+		LayerConfiguration LayerConfiguration{};
+		StepMode Stepping = StepMode::Accumulate;
+		// The maximum number of steps that are simulated in a single frame when accumulating. If a frame takes longer
+		// than this many steps, then the excess time is dropped, which slows down the simulation rather than causing
+		// every following frame to take even longer to catch up.
+		std::uint32_t MaxSubsteps = 8;
+		// Simulates the physics on a dedicated thread, which steps the next frame while the current frame is updated and
+		// drawn. The transform reading functions return the state from the end of the previous frame's simulation, and
+		// contact events are delayed by a frame. FixedUpdate is called from the physics thread, and is the only place
+		// where bodies may be modified or queried directly. Elsewhere, changes should be made through the Queue
+		// functions, or after calling Synchronize.
+		bool Asynchronous = false;
+		// Makes every step reproducible from the same starting state. Steps always use the fixed update rate (the step
+		// mode is forced to Accumulate), Jolt sorts its constraints before solving them, and a hash of the state is
+		// computed after every step, which may be compared across runs with GetStepHashes.
+		bool Deterministic = false;
+		// The maximum number of bodies that may exist at any one time. Creating more bodies will fail.
+		std::uint32_t MaxBodies = 65536;
+		// The number of mutexes that protect bodies from concurrent access. 0 uses Jolt's default.
+		std::uint32_t BodyMutexes = 0;
+		// The maximum number of body pairs that may be queued by the broad phase during a step. Additional pairs are
+		// found in later passes, which is slower.
+		std::uint32_t MaxBodyPairs = 65536;
+		// The maximum number of contact constraints during a step. Contacts past this limit are ignored, which causes
+		// bodies to pass through each other. The peak usage may be read from GetCounters.
+		std::uint32_t MaxContactConstraints = 10240;
+		// The maximum number of contact events recorded during a single update. Additional events are dropped.
+		std::uint32_t MaxContactEvents = 16384;
+		// The size of each block of memory that is used for temporary allocations during a step.
+		std::size_t TempAllocatorSize = 10 * 1024 * 1024;
+		// Whether the temporary allocator adds blocks once the first block is full. Otherwise, allocations that do not
+		// fit fall back to the heap, which is far slower. The high-water mark may be read from GetCounters.
+		bool GrowTempAllocator = true;
+	};
+
 	// The shape of the body's collider.
 	enum class Shape : std::uint8_t {
 		Sphere,
@@ -83,11 +183,16 @@ namespace engine::physics {
 		Capsule,
 		TaperedCapsule,
 		Cylinder,
+		Mesh,
+		HeightField,
+		Compound,
 	};
 
 	// The entity upon which all physics calculations are performed.
 	class Body {
 	public:
+		// Creates an invalid body, which does not refer to any body in the physics system.
+		Body();
 		~Body();
 
 		// Put this body into the awake state
@@ -95,6 +200,8 @@ namespace engine::physics {
 		// Put this body into the sleep state
 		void Deactivate() const;
 
+		// Get whether this refers to a body. Only a default constructed body is invalid.
+		[[nodiscard]] bool IsValid() const;
 		// Get an ID that uniquely identifies this body. This ID is not guaranteed to be unique across the application's
 		// lifetime as IDs are recycled, however it is guaranteed to be unique for the body's lifetime.
 		[[nodiscard]] std::uint32_t GetID() const;
@@ -146,6 +253,8 @@ namespace engine::physics {
 		[[nodiscard]] bool IsStatic() const;
 		// Get whether this body is a sensor
 		[[nodiscard]] bool IsSensor() const;
+		// Get the value that the application associated with this body, such as an entity ID or an object pointer
+		[[nodiscard]] std::uint64_t GetUserData() const;
 		// Casts a ray in the given direction and returns true if the ray did not encounter other bodies before
 		// colliding with this body.
 		[[nodiscard]] bool TestRay(glm::vec3 origin, glm::vec3 direction, float magnitude) const;
@@ -185,6 +294,8 @@ namespace engine::physics {
 		void SetRestitution(float restitution) const;
 		// Set the motion quality of the body
 		void SetMotionQuality(MotionQuality quality) const;
+		// Set the value that the application associates with this body, which is returned by queries and contact events
+		void SetUserData(std::uint64_t userData) const;
 		// Change the body to a sensor. A sensor will receive collision callbacks, but will not cause any collision
 		// responses and can be used as a trigger volume. The cheapest sensor (in terms of CPU usage) is a
 		// MotionType::Static (which may still be moved using SetPosition). These sensors will only detect collisions
@@ -213,16 +324,20 @@ namespace engine::physics {
 		friend inline bool operator>(const Body& lhs, const Body& rhs) { return lhs.id > rhs.id; }
 		friend inline bool operator<=(const Body& lhs, const Body& rhs) { return lhs.id <= rhs.id; }
 		friend inline bool operator>=(const Body& lhs, const Body& rhs) { return lhs.id >= rhs.id; }
-		friend inline bool operator==(const Body& lhs, const Body& rhs) { return lhs.id == rhs.id; }
-		friend inline bool operator!=(const Body& lhs, const Body& rhs) { return lhs.id != rhs.id; }
+		friend inline bool operator==(const Body& lhs, const Body& rhs) { return lhs.id == rhs.id && lhs.manager == rhs.manager; }
+		friend inline bool operator!=(const Body& lhs, const Body& rhs) { return !(lhs == rhs); }
 
 	private:
 		friend class Manager;
 
 		friend class Character;
 
-		Body(uint32_t id, bool destructible = true);
-		uint32_t id = 0;
+		friend class InternalContactListener;
+
+		Body(uint32_t id, Manager* manager, bool destructible = true);
+		uint32_t id = 0xFFFFFFFF;
+		// The world that the body belongs to
+		Manager* manager = nullptr;
 		bool destructible = true;
 	};
 
@@ -257,33 +372,122 @@ namespace engine::physics {
 	private:
 		friend class Manager;
 
-		Character(void* character);
+		Character(void* character, Manager* manager);
 		void* character;
+		Manager* manager;
+	};
+
+	// A character that is moved by collision queries rather than simulated as a body, so it is not part of the broad
+	// phase and does not need PostSimulation. Intended for crowds, where many characters are moved at once through
+	// UpdateCharacters. Virtual characters do not collide with each other.
+	class VirtualCharacter {
+	public:
+		~VirtualCharacter();
+
+		// Get the world space position of the character's feet
+		[[nodiscard]] glm::vec3 GetPosition() const;
+		// Set the world space position of the character's feet, without checking for collisions
+		void SetPosition(glm::vec3 position);
+		// Get the world space rotation of the character
+		[[nodiscard]] glm::quat GetRotation() const;
+		// Set the world space rotation of the character
+		void SetRotation(glm::quat rotation);
+		// Get the linear velocity of the character (m/s)
+		[[nodiscard]] glm::vec3 GetLinearVelocity() const;
+		// Set the linear velocity that the character will move with during the next update (m/s)
+		void SetLinearVelocity(glm::vec3 velocity);
+		// Get the state of the ground in relation to the character, as of the last update.
+		[[nodiscard]] GroundState GetGroundState() const;
+		// Get the normal of the ground. Only relevant when the character has a proper ground state.
+		[[nodiscard]] glm::vec3 GetGroundNormal() const;
+
+	private:
+		friend class Manager;
+
+		VirtualCharacter(void* character, float gravityFactor, Manager* manager);
+		void* character;
+		float gravityFactor;
+		Manager* manager;
+	};
+
+	// A ray in world space, used when casting many rays at once.
+	struct Ray {
+	public:
+		glm::vec3 Origin{};
+		// The direction should not be normalized, as the direction's magnitude determines the length of the ray.
+		glm::vec3 DirectionWithMagnitude{};
 	};
 
 	// The result of a ray cast in the world space.
 	struct RayResult {
 	public:
-		// The body that was hit
+		// The body that was hit. This is invalid if the ray did not hit anything.
 		Body Body;
+		// The user data of the body that was hit, so that the hit object may be found without looking up the body
+		std::uint64_t UserData = 0;
 		// The point, in world space, that the ray made contact with the body
-		glm::vec3 ContactPoint;
+		glm::vec3 ContactPoint{};
+		// The surface normal of the body, in world space, at the contact point
+		glm::vec3 Normal{};
+	};
+
+	// The result of casting a shape through the world space.
+	struct ShapeCastResult {
+	public:
+		// The body that was hit
+		Body Body;
+		// The user data of the body that was hit
+		std::uint64_t UserData = 0;
+		// The point, in world space, that the shape made contact with the body
+		glm::vec3 ContactPoint{};
+		// The surface normal of the body, in world space, at the contact point
+		glm::vec3 Normal{};
+		// How far along the cast the contact occurred, from 0 (the start) to 1 (the end)
+		float Fraction = 0.0f;
+	};
+
+	// The kind of change in contact between two bodies.
+	enum class ContactEventType : std::uint8_t {
+		// The bodies started touching during the step.
+		Added,
+		// The bodies were touching during the previous step, and are still touching.
+		Persisted,
+		// The bodies stopped touching during the step. Removed events do not have a point, normal, or impulse.
+		Removed,
+	};
+
+	// A change in contact between two bodies that occurred during a physics update.
+	struct ContactEvent {
+	public:
+		ContactEventType Type = ContactEventType::Added;
+		Body BodyA;
+		Body BodyB;
+		// The user data of each body. Removed events only have user data when their body still exists.
+		std::uint64_t UserDataA = 0;
+		std::uint64_t UserDataB = 0;
+		// The center of the contact points, in world space, on the surface of BodyA
+		glm::vec3 Point{};
+		// The contact normal in world space, pointing from BodyA towards BodyB
+		glm::vec3 Normal{};
+		// An estimate of the impulse (kg m/s) needed to stop the bodies from approaching each other along the normal,
+		// calculated from their velocities before the contact was resolved.
+		float Impulse = 0.0f;
+		// Whether either body is a sensor, in which case the contact was not resolved. Always false for removed events.
+		bool IsSensor = false;
 	};
 
-	// Receives collision events that occur between physics bodies.
-	class ContactListener {
-		//TODO: implement
-		//void OnContactAdded(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold, JPH::ContactSettings& ioSettings) override;
-		//void OnContactPersisted(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold, JPH::ContactSettings& ioSettings) override;
-		//void OnContactRemoved(const JPH::SubShapeIDPair& inSubShapePair) override;
+	// Whether a body started or stopped overlapping a sensor.
+	enum class SensorEventType : std::uint8_t {
+		Begin,
+		End,
 	};
 
-	// Validates collision events before they're passed to listeners. This allows for fine-grained validation above what
-	// layers offer, however they occur after quite a bit of processing has been done. If possible, prefer to separate
-	// bodies by layer rather than in the validator.
-	class ContactValidator {
-		//TODO: implement
-		//JPH::ValidateResult OnContactValidate(const JPH::Body& inBody1, const JPH::Body& inBody2, JPH::RVec3Arg inBaseOffset, const JPH::CollideShapeResult& inCollisionResult) override;
+	// A change in the set of bodies that overlap a sensor, which occurred during a physics update.
+	struct SensorEvent {
+	public:
+		SensorEventType Type = SensorEventType::Begin;
+		Body Sensor;
+		Body Other;
 	};
 
 	// Enable the physics engine. The engine is enabled by default, so this should only be called if the engine was
@@ -294,17 +498,223 @@ namespace engine::physics {
 	void Disable();
 	// Set the number of updates that the physics engine will calculate per second.
 	void SetUpdateRate(double rate);
+	// Set the maximum number of steps that are simulated in a single frame when accumulating.
+	void SetMaxSubsteps(std::uint32_t maxSubsteps);
+	// Get how far the accumulated time is between the last step and the next step, from 0 to 1. This is always 1 when
+	// not accumulating.
+	double GetInterpolationAlpha();
 	// Get the gravity
 	glm::vec3 GetGravity();
 	// Set the gravity
 	void SetGravity(glm::vec3 gravity);
+	// Get the contact events from every step of the most recent update, sorted by the IDs of BodyA and BodyB. The
+	// events are only valid until the next update, and should be processed from Update rather than FixedUpdate.
+	std::span<const ContactEvent> GetContactEvents();
+	// Get the bodies that started or stopped overlapping a sensor during the most recent update, in step order, and
+	// sorted by the IDs of both bodies within a step. A body that begins and ends overlapping within a single update has
+	// both events. Sensors are tracked separately from the contact events, so they are not affected by
+	// MaxContactEvents. The events are only valid until the next update.
+	std::span<const SensorEvent> GetSensorEvents();
+	// Get the bodies that currently overlap the given sensor. The overlaps are updated during each step, so they should
+	// only be read after calling Synchronize when the physics are asynchronous. The span is only valid until the next
+	// update.
+	std::span<const Body> GetSensorOverlaps(const Body& sensor);
 	// Get the maximum number of physics bodies that may be created at any one time.
 	std::uint32_t GetMaxNumberOfBodies();
+
+	// Measurements of the physics engine's memory and capacity usage, which may be used to size the PhysicsOptions.
+	struct PhysicsCounters {
+	public:
+		std::uint32_t Bodies = 0;
+		std::uint32_t MaxBodies = 0;
+		// The number of contact manifolds during the most recent step. There is a manifold for each pair of touching
+		// sub shapes, excluding those of sensors, and each manifold takes one of the MaxContactConstraints.
+		std::uint32_t ContactManifolds = 0;
+		// The largest number of contact manifolds during a single step
+		std::uint32_t PeakContactManifolds = 0;
+		std::uint32_t MaxContactConstraints = 0;
+		// The largest number of contact events recorded during a single update
+		std::uint32_t PeakContactEvents = 0;
+		std::uint32_t MaxContactEvents = 0;
+		// The most memory that the temporary allocator has had in use at once
+		std::size_t TempAllocatorHighWaterMark = 0;
+		// The total size of the temporary allocator's blocks
+		std::size_t TempAllocatorCapacity = 0;
+		// The number of temporary allocations that did not fit into the temporary allocator
+		std::uint32_t TempAllocatorOverflows = 0;
+	};
+
+	// Get the counters that measure the physics engine's usage. Peak values are measured since the physics engine was
+	// initialized, or since the last call to ResetPeakCounters.
+	PhysicsCounters GetCounters();
+	// Resets the peak values of the counters to their current values.
+	void ResetPeakCounters();
 	// Casts a ray in world space against all bodies and returns those that collide with the ray.
-	std::vector<RayResult> CastRay(glm::vec3 origin, glm::vec3 direction, float magnitude, RayFilter filter);
+	std::vector<RayResult> CastRay(glm::vec3 origin, glm::vec3 direction, float magnitude, RayFilter filter, LayerMask layers = AllLayers);
 	// Casts a ray in world space against all bodies and returns those that collide with the ray. The direction should
 	// not be normalized, as the direction's magnitude determines the length of the ray.
-	std::vector<RayResult> CastRay(glm::vec3 origin, glm::vec3 directionWithMagnitude, RayFilter filter);
+	std::vector<RayResult> CastRay(glm::vec3 origin, glm::vec3 directionWithMagnitude, RayFilter filter, LayerMask layers = AllLayers);
+	// Casts every ray in world space against all bodies, spreading the rays across the physics job threads, and writes
+	// the result of each ray into the matching index of the results, which must be at least as large as the rays. As
+	// each ray has a single result, AllHit is treated as ClosestHit. Rays that do not hit anything have an invalid
+	// body. This must not be called while bodies are being added or removed from another thread.
+	void CastRays(std::span<const Ray> rays, RayFilter filter, std::span<RayResult> results, LayerMask layers = AllLayers);
+	// Sweeps a sphere in world space against all bodies and returns those that it collides with. The direction should
+	// not be normalized, as the direction's magnitude determines the length of the sweep.
+	std::vector<ShapeCastResult> CastSphere(glm::vec3 origin, float radius, glm::vec3 directionWithMagnitude, RayFilter filter, LayerMask layers = AllLayers);
+	// Sweeps a capsule in world space against all bodies and returns those that it collides with. Height is the
+	// distance between the centers of the two hemispheres, and the capsule is aligned to the Y axis before rotating.
+	// The direction should not be normalized, as the direction's magnitude determines the length of the sweep.
+	std::vector<ShapeCastResult> CastCapsule(glm::vec3 origin, glm::quat rotation, float height, float radius, glm::vec3 directionWithMagnitude, RayFilter filter, LayerMask layers = AllLayers);
+	// Returns every body that overlaps a sphere in world space.
+	std::vector<Body> OverlapSphere(glm::vec3 center, float radius, LayerMask layers = AllLayers);
+	// Returns every body that overlaps a box in world space.
+	std::vector<Body> OverlapBox(glm::vec3 center, glm::quat rotation, glm::vec3 size, LayerMask layers = AllLayers);
+	// Returns every body that overlaps a capsule in world space. Height is the distance between the centers of the two
+	// hemispheres, and the capsule is aligned to the Y axis before rotating.
+	std::vector<Body> OverlapCapsule(glm::vec3 center, glm::quat rotation, float height, float radius, LayerMask layers = AllLayers);
+	// Reads the world space position and rotation of every given body into the matching index of the output arrays,
+	// which must be at least as large as the body array. Bodies are read without taking their locks, so this must not
+	// be called while bodies are being modified from another thread (such as from within FixedUpdate). In asynchronous
+	// mode, bodies may only be created directly from within FixedUpdate or after calling Synchronize, and must
+	// otherwise be created through QueueSpawn. Bodies created after calling Synchronize are read as the origin until
+	// the next frame.
+	void ReadTransforms(std::span<const Body> bodies, std::span<glm::vec3> positions, std::span<glm::quat> rotations);
+	// Reads the ID, world space position and rotation of every active (non-sleeping) body into the output arrays, and
+	// returns the number of bodies that were written. Bodies that do not fit into the output arrays are skipped. Bodies
+	// are read without taking their locks, so the same restrictions as ReadTransforms apply.
+	std::size_t ReadActiveTransforms(std::span<std::uint32_t> ids, std::span<glm::vec3> positions, std::span<glm::quat> rotations);
+	// Reads the world space position and rotation of every given body, interpolated between the last two steps by the
+	// interpolation alpha, into the matching index of the output arrays. Bodies that were not active during the last
+	// step return their current transform. The same restrictions as ReadTransforms apply.
+	void ReadInterpolatedTransforms(std::span<const Body> bodies, std::span<glm::vec3> positions, std::span<glm::quat> rotations);
+	// Get the number of bodies that are currently active (non-sleeping).
+	std::uint32_t GetNumberOfActiveBodies();
+	// Get the state hash of every step that was simulated during the most recent update, in the order that they were
+	// simulated. Hashes are only computed in deterministic mode.
+	std::span<const std::uint64_t> GetStepHashes();
+	// Get a hash of the position, rotation, and velocity of every body.
+	std::uint64_t HashState();
+
+	// Measurements of a single step, for finding which steps are slow and why.
+	struct PhysicsStepStats {
+	public:
+		// The time spent by Jolt simulating the step, in seconds, excluding the fixed update
+		double Duration = 0.0;
+		std::uint32_t Bodies = 0;
+		// The number of bodies that were active (non-sleeping) once the step finished
+		std::uint32_t ActiveBodies = 0;
+		// The number of contact manifolds during the step, excluding those of sensors
+		std::uint32_t ContactManifolds = 0;
+		// The most memory that the temporary allocator had in use at once during the step
+		std::size_t TempAllocatorUsage = 0;
+	};
+
+	// Get the measurements of every step that was simulated during the most recent update, in the order that they were
+	// simulated. The time spent within each of Jolt's phases may be captured with engine::profile when the engine is
+	// built with ENGINE_PHYSICS_PROFILE, and every step is also recorded as a profile sample and counters.
+	std::span<const PhysicsStepStats> GetStepStats();
+
+	// The outcome of VerifyDeterminism.
+	struct DeterminismResult {
+	public:
+		bool Deterministic = true;
+		// The first step whose hash differed between runs, when the runs were not deterministic
+		std::uint32_t FirstDivergentStep = 0;
+		// The hash of the first divergent step during the first run
+		std::uint64_t ExpectedHash = 0;
+		// The hash of the first divergent step during the run that differed
+		std::uint64_t ActualHash = 0;
+	};
+
+	// Simulates the given number of steps from the current state several times, restoring the state before each run,
+	// and compares the state hash after each step across the runs. FixedUpdate is not called during the runs, and the
+	// state is restored once verification has finished. Bodies must not be added or removed from another thread while
+	// verifying.
+	DeterminismResult VerifyDeterminism(std::uint32_t steps, std::uint32_t runs = 2);
+	// Waits for the physics thread to finish simulating, after which bodies may be modified or queried directly until
+	// the next update. This does nothing when the physics are not asynchronous.
+	void Synchronize();
+	// Queues a force (N) that is applied to the body's center of mass during the next step.
+	void QueueForce(const Body& body, glm::vec3 force);
+	// Queues an impulse (kg m/s) that is applied to the body's center of mass before the next step.
+	void QueueImpulse(const Body& body, glm::vec3 impulse);
+	// Queues a move of the body to the given position and rotation before the next step, which also activates it.
+	void QueueTeleport(const Body& body, glm::vec3 position, glm::quat rotation);
+
+	// CommandBuffer records changes to many bodies into a flat array, so that they may be applied together rather than
+	// locking each body for every change. A buffer may be recorded from any thread, but only by one thread at a time.
+	class CommandBuffer {
+	public:
+		// Adds force (N) at the center of mass for the next time step
+		void AddForce(const Body& body, glm::vec3 force);
+		// Adds an impulse to the center of mass (kg m/s)
+		void AddImpulse(const Body& body, glm::vec3 impulse);
+		// Set the world space linear velocity of the center of mass (m/s), clamped to the body's max linear velocity
+		void SetLinearVelocity(const Body& body, glm::vec3 velocity);
+		// Set the velocity of the body such that it will translate/rotate by position/rotation in some seconds
+		void MoveKinematic(const Body& body, glm::vec3 position, glm::quat rotation, float seconds);
+		// Set the world space position of the body. Can choose to forcefully activate the body if it's sleeping.
+		void SetPosition(const Body& body, glm::vec3 position, bool forceActivate = false);
+		// Set the world space position and rotation of the body. Can choose to forcefully activate the body if it's sleeping.
+		void SetPositionAndRotation(const Body& body, glm::vec3 position, glm::quat rotation, bool forceActivate = false);
+		// Reserves space for the given number of commands, so that recording them does not allocate.
+		void Reserve(std::size_t count);
+		// Discards all recorded commands.
+		void Clear();
+		// Get the number of recorded commands.
+		[[nodiscard]] std::size_t Size() const;
+
+	private:
+		friend class Manager;
+
+		struct command {
+		public:
+			enum class Kind : std::uint8_t {
+				Force,
+				Impulse,
+				LinearVelocity,
+				MoveKinematic,
+				Position,
+				PositionAndRotation,
+			};
+
+			Kind Type;
+			bool Activate = false;
+			std::uint32_t BodyID;
+			glm::vec3 Vector{};
+			glm::quat Rotation = glm::identity<glm::quat>();
+			float Seconds = 0.0f;
+		};
+
+		std::vector<command> commands;
+	};
+
+	// Submits the buffer's commands to be applied before the next step, leaving the buffer empty. Commands are sorted by
+	// body and applied in a single pass, and commands to the same body are applied in the order that they were recorded.
+	// The buffer keeps an allocation, so reusing a buffer every frame does not allocate once it is large enough.
+	void SubmitCommands(CommandBuffer& buffer);
+
+	// The serialized state of the simulation, which contains the motion of every body along with the cached contacts.
+	// It does not contain the bodies themselves, so a state may only be restored while the same bodies exist.
+	struct PhysicsState {
+	public:
+		std::vector<std::uint8_t> Data;
+	};
+
+	// Saves the current state of the simulation. The state's existing allocation is reused, so saving into the same
+	// state every frame does not allocate once its capacity is large enough.
+	void SaveState(PhysicsState& state);
+	// Restores the simulation to a saved state in place, without recreating any bodies. Returns false if the state
+	// could not be restored, such as when bodies have been added or removed since the state was saved, in which case
+	// the simulation may be partially restored.
+	bool RestoreState(const PhysicsState& state);
+	// Writes the difference between two states into the delta, which is far smaller than the target state when only a
+	// few bodies have changed. The delta's existing allocation is reused.
+	void CreateStateDelta(const PhysicsState& base, const PhysicsState& target, std::vector<std::uint8_t>& delta);
+	// Rebuilds the target state from its base and a delta created by CreateStateDelta. Returns false if the delta is
+	// malformed or does not belong to the base, in which case the target is left unchanged.
+	bool ApplyStateDelta(const PhysicsState& base, std::span<const std::uint8_t> delta, PhysicsState& target);
 
 	// The set of parameters that govern the creation of all bodies.
 	struct BodyCreationProperties {
@@ -314,8 +724,44 @@ namespace engine::physics {
 		MotionType MotionType = MotionType::Dynamic;
 		MotionQuality MotionQuality = MotionQuality::Discrete;
 		Mass Mass{};
+		// The object layer of the body. When empty, static bodies use NON_MOVING and all others use MOVING.
+		std::optional<Layer> Layer{};
+		// A value that the application associates with the body, such as an entity ID or an object pointer. It's
+		// returned with ray results, shape cast results and contact events.
+		std::uint64_t UserData = 0;
+	};
+
+	// The set of parameters that define a body's shape. Only the dimensions that are used by the chosen shape are read.
+	// Meshes, height fields and compounds are cooked ahead of time, so they can only be created through their own
+	// create functions.
+	struct ShapeProperties {
+	public:
+		Shape Type = Shape::Box;
+		glm::vec3 Size{1.0f}; // Box
+		float Radius = 0.5f; // Sphere, Capsule, Cylinder, and the top of a TaperedCapsule
+		float BottomRadius = 0.5f; // TaperedCapsule
+		float Height = 1.0f; // Capsule, TaperedCapsule, Cylinder. Same meaning as in the individual create functions.
 	};
 
+	// A single shape within a compound, positioned relative to the compound's origin.
+	struct CompoundChild {
+	public:
+		ShapeProperties Shape{};
+		glm::vec3 Position{};
+		glm::quat Rotation = glm::identity<glm::quat>();
+	};
+
+	// The set of parameters that govern the creation of a body within a batch.
+	struct BatchBodyCreationProperties {
+	public:
+		ShapeProperties Shape{};
+		BodyCreationProperties Body{};
+	};
+
+	// Bodies that are created with the same shape, dimensions and mass share a single collision shape. Shared shapes
+	// are kept after their last body is destroyed, so that respawning them is cheap. This releases every shared shape
+	// that is no longer used by a body.
+	void ClearUnusedShapes();
 	// Returns a new sphere. Will return a nullptr once the max body count has been reached.
 	std::unique_ptr<Body> CreateSphere(float radius, BodyCreationProperties properties);
 	// Returns a new box. Will return a nullptr once the max body count has been reached.
@@ -328,8 +774,155 @@ namespace engine::physics {
 	// Returns a new cylinder. Will return a nullptr once the max body count has been reached.
 	std::unique_ptr<Body> CreateCylinder(float height, float radius, BodyCreationProperties properties);
 
+	// Cooking builds a shape ahead of time and writes it to a file, so that loading it later is a fast deserialize rather
+	// than a rebuild. Cooked files are tied to the engine's version of Jolt, and are rejected if the layout changes.
+	// Cooks a triangle mesh, where every three indices form a triangle. Returns false if the mesh could not be cooked
+	// or written.
+	bool CookMesh(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, std::span<const glm::vec3> vertices, std::span<const std::uint32_t> indices);
+	// Cooks a height field from a square grid of sampleCount by sampleCount heights in row major order. The sample at
+	// (x, z) is placed at offset + scale * (x, height, z). Returns false if the height field could not be cooked or
+	// written.
+	bool CookHeightField(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, std::span<const float> heights, std::uint32_t sampleCount, glm::vec3 offset, glm::vec3 scale);
+	// Cooks a compound of the given children, each using the given mass. Returns false if the compound could not be
+	// cooked or written.
+	bool CookCompound(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, std::span<const CompoundChild> children, Mass mass);
+	// Returns a new body from a cooked mesh. Meshes cannot be dynamic. Cooked shapes are cached by their path until
+	// ClearUnusedShapes, and the properties' mass is ignored as it is part of the cooked shape. Will return a nullptr
+	// if the file could not be loaded, or once the max body count has been reached.
+	std::unique_ptr<Body> CreateMesh(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, BodyCreationProperties properties);
+	// Returns a new body from a cooked height field. Height fields cannot be dynamic. Otherwise the same as CreateMesh.
+	std::unique_ptr<Body> CreateHeightField(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, BodyCreationProperties properties);
+	// Returns a new body from a cooked compound. Otherwise the same as CreateMesh.
+	std::unique_ptr<Body> CreateCompound(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, BodyCreationProperties properties);
+
+	// Creates all of the given bodies and inserts them into the broad phase as a single batch, followed by a single
+	// broad phase optimization. This is far cheaper than creating bodies one at a time, and is intended for loading
+	// levels. The optimization rebuilds the entire broad phase, so small batches that are created often, such as
+	// streamed or spawned bodies, should skip it by passing false for optimizeBroadPhase. Bodies are returned in the
+	// same order as the given properties, so the returned vector always has one body per property. A body whose shape
+	// could not be created is invalid, and once the max body count is reached, all remaining bodies are invalid. The
+	// returned bodies are not destroyed when they go out of scope, and must instead be destroyed using DestroyBodies.
+	std::vector<Body> CreateBodies(std::span<const BatchBodyCreationProperties> properties, bool optimizeBroadPhase = true);
+	// Removes and destroys all of the given bodies as a single batch. This should only be used for bodies returned
+	// from CreateBodies, as all other bodies are destroyed when they go out of scope. Invalid bodies are ignored.
+	void DestroyBodies(std::span<const Body> bodies);
+	// Queues a body to be created, as though by CreateBodies, before the next step. The spawned bodies are returned
+	// from GetSpawnedBodies after the next update, in the order that they were queued. Spawns that could not be created
+	// are returned as invalid bodies.
+	void QueueSpawn(const BatchBodyCreationProperties& properties);
+	// Get the bodies that were spawned from the queue during the most recent update. These must be destroyed using
+	// DestroyBodies. The span is only valid until the next update.
+	std::span<const Body> GetSpawnedBodies();
+
 	// Returns a new character. Will return a nullptr once the max body count has been reached.
 	std::unique_ptr<Character> CreateCharacter(CharacterCreationProperties properties);
+	// Returns a new virtual character, which does not count towards the max body count.
+	std::unique_ptr<VirtualCharacter> CreateVirtualCharacter(CharacterCreationProperties properties);
+	// Moves all of the given characters by their velocity over the given time, in parallel on the job system. Gravity
+	// is added to the velocity of characters that are not supported by the ground. This should be called from
+	// FixedUpdate with its delta time, and a character must not appear more than once.
+	void UpdateCharacters(std::span<VirtualCharacter* const> characters, float deltaTime);
+
+	// World is an independent physics simulation with its own bodies, owned by the application. The free functions
+	// operate on the global world unless a world has been made current on the calling thread, and bodies always act on
+	// the world that created them. All worlds share the engine's job system.
+	class World {
+	public:
+		// Scope makes a world current on the calling thread until it is destroyed, restoring the previous world.
+		class Scope {
+		public:
+			~Scope();
+			Scope(const Scope&) = delete;
+			Scope& operator=(const Scope&) = delete;
+
+		private:
+			explicit Scope(Manager* manager);
+
+			Manager* previousManager;
+
+			friend class World;
+		};
+
+		~World();
+		World(const World&) = delete;
+		World& operator=(const World&) = delete;
+		// Creates a new world. Worlds do not call the application's FixedUpdate, so use SetFixedUpdate instead.
+		static std::unique_ptr<World> Create(const PhysicsOptions& options);
+		// Advances the world by the given time, in seconds.
+		void Update(double deltaTime);
+		// Set the function that is called before every step of this world. The world is current while it is called.
+		void SetFixedUpdate(std::function<void(double)> function);
+		// Makes this world current on the calling thread for the lifetime of the returned scope.
+		[[nodiscard]] Scope MakeCurrent();
+
+	private:
+		explicit World(std::unique_ptr<Manager> manager);
+
+		std::unique_ptr<Manager> manager;
+
+		friend void UpdateWorlds(std::span<World* const> worlds, double deltaTime);
+	};
+
+	// Advances all of the given worlds by the given time in parallel, returning once every world has been updated. A
+	// world must not appear more than once.
+	void UpdateWorlds(std::span<World* const> worlds, double deltaTime);
+
+	// The set of parameters that govern how cells are streamed. Cells are squares on the XZ plane.
+	struct StreamingOptions {
+	public:
+		float CellSize = 64.0f; // meters
+		// Cells within this distance of any observer are loaded.
+		float LoadRadius = 128.0f; // meters
+		// Loaded cells are only unloaded once they're beyond this distance of every observer. Keeping this larger than
+		// the load radius stops cells on the boundary from being loaded and unloaded repeatedly.
+		float UnloadRadius = 160.0f; // meters
+		// The number of cell files that may be read at the same time.
+		std::uint32_t MaxPendingLoads = 8;
+		// The number of loaded cells whose bodies may be inserted in a single update, which bounds the cost of an update.
+		std::uint32_t MaxInsertsPerUpdate = 2;
+	};
+
+	// Writes the bodies of a cell to the file that a CellStreamer reads for the cell at the given coordinates. Only
+	// bodies with the shapes in ShapeProperties may be written. Returns false if the file could not be written.
+	bool WriteCell(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& directory, std::int32_t x, std::int32_t z, std::span<const BatchBodyCreationProperties> bodies);
+
+	// CellStreamer divides a world into cells, and keeps only the cells near the observers loaded, so that the number of
+	// bodies stays bounded regardless of the size of the world. Cell files are read on the job system, and each cell's
+	// bodies are created and destroyed as a single batch. The streamer acts on the world that is current when it is
+	// created, and must be destroyed before that world. The file system is read from job threads.
+	class CellStreamer {
+	public:
+		CellStreamer(engine::fs::IFileSystem& fileSystem, std::filesystem::path directory, const StreamingOptions& options);
+		// Waits for any cell that is still being read, and destroys every loaded cell's bodies.
+		~CellStreamer();
+		CellStreamer(const CellStreamer&) = delete;
+		CellStreamer& operator=(const CellStreamer&) = delete;
+
+		// Starts loading the cells that are near the observers, inserts the cells that have finished loading, and
+		// removes the cells that are far from every observer. This should be called once per frame.
+		void Update(std::span<const glm::vec3> observers);
+		// Get the number of cells whose bodies are in the world.
+		[[nodiscard]] std::uint32_t GetLoadedCellCount() const;
+		// Get the number of cells that are being read or are waiting to be inserted.
+		[[nodiscard]] std::uint32_t GetPendingCellCount() const;
+		// Get the bodies of the cell at the given coordinates, which is empty if the cell is not loaded.
+		[[nodiscard]] std::span<const Body> GetCellBodies(std::int32_t x, std::int32_t z) const;
+
+	private:
+		struct pendingCell;
+
+		// Returns the distance on the XZ plane from the position to the nearest point of the cell.
+		[[nodiscard]] float distanceToCell(glm::vec3 position, std::int32_t x, std::int32_t z) const;
+
+		Manager* manager;
+		engine::fs::IFileSystem* fileSystem;
+		std::filesystem::path directory;
+		StreamingOptions options;
+		// Cells are keyed by their coordinates packed into a single integer
+		std::unordered_map<std::uint64_t, std::unique_ptr<pendingCell>> pendingCells;
+		std::unordered_map<std::uint64_t, std::vector<Body>> loadedCells;
+		std::unique_ptr<engine::jobs::Group> loads;
+	};
 }
 
 #endif //ENGINE_PHYSICS_PHYSICS_HPP
@@ -0,0 +1,67 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ENGINE_PROFILE_PROFILE_HPP
+#define ENGINE_PROFILE_PROFILE_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace engine::fs {
+	class IFileSystem;
+}
+
+namespace engine::profile {
+	// A timed scope that was recorded during a capture. Times are in nanoseconds from the start of the capture.
+	struct Sample {
+	public:
+		const char* Name;
+		// Identifies the thread that recorded the sample. Threads are numbered in the order that they first record.
+		std::uint32_t ThreadID;
+		std::uint64_t Start;
+		std::uint64_t Duration;
+	};
+
+	// A value that was recorded during a capture, such as a count or a size. Shown as a graph in trace viewers.
+	struct Counter {
+	public:
+		const char* Name;
+		std::uint64_t Time;
+		double Value;
+	};
+
+	// Scope times the region from its construction until its destruction, and records it as a sample when a capture is
+	// running. The name must outlive the capture, so string literals should be used. Scopes cost two clock reads while
+	// capturing, and a single atomic load otherwise.
+	class Scope {
+	public:
+		explicit Scope(const char* name);
+		~Scope();
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+		const char* name;
+		std::uint64_t start;
+	};
+
+	// Starts a new capture, discarding the samples of the previous capture.
+	void BeginCapture();
+	// Stops the capture. The captured samples remain until the next capture begins.
+	void EndCapture();
+	// Get whether a capture is running.
+	bool IsCapturing();
+	// Records a counter value when a capture is running.
+	void RecordCounter(const char* name, double value);
+	// Get every sample and counter of the most recent capture, sorted by their time. Should not be called while capturing.
+	void GetCapture(std::vector<Sample>& samples, std::vector<Counter>& counters);
+	// Writes the most recent capture in the Chrome trace event format, which may be opened by chrome://tracing and
+	// Perfetto. Returns false if the file could not be written. Should not be called while capturing.
+	bool WriteChromeTrace(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path);
+}
+
+#endif //ENGINE_PROFILE_PROFILE_HPP
@@ -0,0 +1,332 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ENGINE_UTILS_QUEUE_HPP
+#define ENGINE_UTILS_QUEUE_HPP
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace engine::utils {
+	// The assumed size of a cache line. Indexes that are written by different threads are placed on separate cache
+	// lines so that a producer and a consumer do not invalidate each other's cache on every operation.
+	static constexpr std::size_t CacheLineSize = 64;
+
+	// A bounded, lock-free queue for handing data from exactly one producer thread to exactly one consumer thread.
+	// The capacity is rounded up to the next power of 2. T must be default constructible and move assignable.
+	template<typename T>
+	class SPSCQueue {
+	public:
+		SPSCQueue(std::size_t capacity);
+		~SPSCQueue();
+
+		SPSCQueue(const SPSCQueue&) = delete;
+		SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+		// Adds an item to the queue. Returns false if the queue is full. Must only be called from the producer thread.
+		bool Push(const T& item);
+		// Adds an item to the queue. Returns false if the queue is full. Must only be called from the producer thread.
+		bool Push(T&& item);
+		// Adds up to count items to the queue, returning the number of items that were added. Items are added in order,
+		// so the remaining items may be pushed later. Must only be called from the producer thread.
+		std::size_t PushBatch(const T* items, std::size_t count);
+		// Removes the oldest item from the queue. Returns false if the queue is empty. Must only be called from the
+		// consumer thread.
+		bool Pop(T& item);
+		// Removes up to maxCount of the oldest items from the queue, returning the number of items that were removed.
+		// Must only be called from the consumer thread.
+		std::size_t PopBatch(T* items, std::size_t maxCount);
+		// Returns the number of items in the queue. This is only a snapshot, as other threads may modify the queue.
+		[[nodiscard]] std::size_t Size() const;
+		// Returns the maximum number of items that the queue can hold.
+		[[nodiscard]] std::size_t Capacity() const;
+
+	private:
+		// Written by the consumer
+		alignas(CacheLineSize) std::atomic<std::size_t> head{0};
+		std::size_t cachedTail = 0;
+		// Written by the producer
+		alignas(CacheLineSize) std::atomic<std::size_t> tail{0};
+		std::size_t cachedHead = 0;
+		// Only written on construction
+		alignas(CacheLineSize) T* slots;
+		std::size_t mask;
+	};
+
+	// A bounded, lock-free queue for handing data from any number of producer threads to exactly one consumer thread.
+	// The capacity is rounded up to the next power of 2. T must be default constructible and move assignable.
+	template<typename T>
+	class MPSCQueue {
+	public:
+		MPSCQueue(std::size_t capacity);
+		~MPSCQueue();
+
+		MPSCQueue(const MPSCQueue&) = delete;
+		MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+		// Adds an item to the queue. Returns false if the queue is full. May be called from any thread.
+		bool Push(const T& item);
+		// Adds an item to the queue. Returns false if the queue is full. May be called from any thread.
+		bool Push(T&& item);
+		// Adds up to count items to the queue, returning the number of items that were added. The added items are
+		// contiguous in the queue, so they will not be interleaved with items from other producers. May be called from
+		// any thread.
+		std::size_t PushBatch(const T* items, std::size_t count);
+		// Removes the oldest item from the queue. Returns false if the queue is empty. Must only be called from the
+		// consumer thread.
+		bool Pop(T& item);
+		// Removes up to maxCount of the oldest items from the queue, returning the number of items that were removed.
+		// Must only be called from the consumer thread.
+		std::size_t PopBatch(T* items, std::size_t maxCount);
+		// Returns the number of items in the queue. This is only a snapshot, as other threads may modify the queue.
+		[[nodiscard]] std::size_t Size() const;
+		// Returns the maximum number of items that the queue can hold.
+		[[nodiscard]] std::size_t Capacity() const;
+
+	private:
+		// Each cell's sequence determines its state. When the sequence equals a producer's position, the cell is free
+		// for that position. When it equals the position plus one, the cell holds an item that is ready to be consumed.
+		struct Cell {
+		public:
+			std::atomic<std::size_t> Sequence;
+			T Data;
+		};
+
+		template<typename U>
+		bool push(U&& item);
+
+		// Written by the consumer
+		alignas(CacheLineSize) std::atomic<std::size_t> head{0};
+		// Written by the producers
+		alignas(CacheLineSize) std::atomic<std::size_t> tail{0};
+		// Only written on construction
+		alignas(CacheLineSize) Cell* cells;
+		std::size_t mask;
+	};
+
+	template<typename T>
+	SPSCQueue<T>::SPSCQueue(std::size_t capacity) {
+		capacity = std::bit_ceil(capacity < 2 ? std::size_t(2) : capacity);
+		slots = new T[capacity];
+		mask = capacity - 1;
+	}
+
+	template<typename T>
+	SPSCQueue<T>::~SPSCQueue() {
+		delete[] slots;
+	}
+
+	template<typename T>
+	bool SPSCQueue<T>::Push(const T& item) {
+		T copy = item;
+		return Push(std::move(copy));
+	}
+
+	template<typename T>
+	bool SPSCQueue<T>::Push(T&& item) {
+		std::size_t currentTail = tail.load(std::memory_order_relaxed);
+		if (currentTail - cachedHead > mask) {
+			// Only reload the consumer's index once our cached copy says that we're full
+			cachedHead = head.load(std::memory_order_acquire);
+			if (currentTail - cachedHead > mask) {
+				return false;
+			}
+		}
+		slots[currentTail & mask] = std::move(item);
+		tail.store(currentTail + 1, std::memory_order_release);
+		return true;
+	}
+
+	template<typename T>
+	std::size_t SPSCQueue<T>::PushBatch(const T* items, std::size_t count) {
+		std::size_t currentTail = tail.load(std::memory_order_relaxed);
+		std::size_t available = (mask + 1) - (currentTail - cachedHead);
+		if (available < count) {
+			cachedHead = head.load(std::memory_order_acquire);
+			available = (mask + 1) - (currentTail - cachedHead);
+		}
+		if (count > available) {
+			count = available;
+		}
+		for (std::size_t i = 0; i < count; i++) {
+			slots[(currentTail + i) & mask] = items[i];
+		}
+		tail.store(currentTail + count, std::memory_order_release);
+		return count;
+	}
+
+	template<typename T>
+	bool SPSCQueue<T>::Pop(T& item) {
+		std::size_t currentHead = head.load(std::memory_order_relaxed);
+		if (currentHead == cachedTail) {
+			// Only reload the producer's index once our cached copy says that we're empty
+			cachedTail = tail.load(std::memory_order_acquire);
+			if (currentHead == cachedTail) {
+				return false;
+			}
+		}
+		item = std::move(slots[currentHead & mask]);
+		head.store(currentHead + 1, std::memory_order_release);
+		return true;
+	}
+
+	template<typename T>
+	std::size_t SPSCQueue<T>::PopBatch(T* items, std::size_t maxCount) {
+		std::size_t currentHead = head.load(std::memory_order_relaxed);
+		std::size_t available = cachedTail - currentHead;
+		if (available < maxCount) {
+			cachedTail = tail.load(std::memory_order_acquire);
+			available = cachedTail - currentHead;
+		}
+		if (maxCount > available) {
+			maxCount = available;
+		}
+		for (std::size_t i = 0; i < maxCount; i++) {
+			items[i] = std::move(slots[(currentHead + i) & mask]);
+		}
+		head.store(currentHead + maxCount, std::memory_order_release);
+		return maxCount;
+	}
+
+	template<typename T>
+	std::size_t SPSCQueue<T>::Size() const {
+		std::size_t currentHead = head.load(std::memory_order_acquire);
+		std::size_t currentTail = tail.load(std::memory_order_acquire);
+		return (currentTail >= currentHead) ? currentTail - currentHead : 0;
+	}
+
+	template<typename T>
+	std::size_t SPSCQueue<T>::Capacity() const {
+		return mask + 1;
+	}
+
+	template<typename T>
+	MPSCQueue<T>::MPSCQueue(std::size_t capacity) {
+		capacity = std::bit_ceil(capacity < 2 ? std::size_t(2) : capacity);
+		cells = new Cell[capacity];
+		for (std::size_t i = 0; i < capacity; i++) {
+			cells[i].Sequence.store(i, std::memory_order_relaxed);
+		}
+		mask = capacity - 1;
+	}
+
+	template<typename T>
+	MPSCQueue<T>::~MPSCQueue() {
+		delete[] cells;
+	}
+
+	template<typename T>
+	bool MPSCQueue<T>::Push(const T& item) {
+		return push(item);
+	}
+
+	template<typename T>
+	bool MPSCQueue<T>::Push(T&& item) {
+		return push(std::move(item));
+	}
+
+	// Adapted from Dmitry Vyukov's bounded MPMC queue, restricted to a single consumer
+	template<typename T>
+	template<typename U>
+	bool MPSCQueue<T>::push(U&& item) {
+		std::size_t position = tail.load(std::memory_order_relaxed);
+		Cell* cell;
+		while (true) {
+			cell = &cells[position & mask];
+			std::size_t sequence = cell->Sequence.load(std::memory_order_acquire);
+			auto difference = (std::intptr_t)sequence - (std::intptr_t)position;
+			if (difference == 0) {
+				if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+					break;
+				}
+			} else if (difference < 0) {
+				return false;
+			} else {
+				position = tail.load(std::memory_order_relaxed);
+			}
+		}
+		cell->Data = std::forward<U>(item);
+		cell->Sequence.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	template<typename T>
+	std::size_t MPSCQueue<T>::PushBatch(const T* items, std::size_t count) {
+		if (count == 0) [[unlikely]] {
+			return 0;
+		}
+		std::size_t position = tail.load(std::memory_order_relaxed);
+		std::size_t claimed;
+		while (true) {
+			// The consumer releases cells in order, and updates the head only after the cells have been released, so
+			// every cell before the capacity limit is guaranteed to be free for us to claim.
+			std::size_t currentHead = head.load(std::memory_order_acquire);
+			if ((std::intptr_t)(position - currentHead) < 0) {
+				// Our position is older than items that have already been consumed, so we retry with the current tail
+				position = tail.load(std::memory_order_relaxed);
+				continue;
+			}
+			std::size_t used = position - currentHead;
+			if (used > mask) {
+				return 0;
+			}
+			claimed = (mask + 1) - used;
+			if (claimed > count) {
+				claimed = count;
+			}
+			if (tail.compare_exchange_weak(position, position + claimed, std::memory_order_relaxed)) {
+				break;
+			}
+		}
+		for (std::size_t i = 0; i < claimed; i++) {
+			Cell& cell = cells[(position + i) & mask];
+			cell.Data = items[i];
+			cell.Sequence.store(position + i + 1, std::memory_order_release);
+		}
+		return claimed;
+	}
+
+	template<typename T>
+	bool MPSCQueue<T>::Pop(T& item) {
+		return PopBatch(&item, 1) == 1;
+	}
+
+	template<typename T>
+	std::size_t MPSCQueue<T>::PopBatch(T* items, std::size_t maxCount) {
+		std::size_t position = head.load(std::memory_order_relaxed);
+		std::size_t count = 0;
+		for (; count < maxCount; count++) {
+			Cell& cell = cells[(position + count) & mask];
+			// Producers may finish out of order, so we stop at the first cell that has not been published yet
+			if (cell.Sequence.load(std::memory_order_acquire) != position + count + 1) {
+				break;
+			}
+			items[count] = std::move(cell.Data);
+			cell.Sequence.store(position + count + mask + 1, std::memory_order_release);
+		}
+		if (count > 0) {
+			head.store(position + count, std::memory_order_release);
+		}
+		return count;
+	}
+
+	template<typename T>
+	std::size_t MPSCQueue<T>::Size() const {
+		std::size_t currentHead = head.load(std::memory_order_acquire);
+		std::size_t currentTail = tail.load(std::memory_order_acquire);
+		return (currentTail >= currentHead) ? currentTail - currentHead : 0;
+	}
+
+	template<typename T>
+	std::size_t MPSCQueue<T>::Capacity() const {
+		return mask + 1;
+	}
+}
+
+#endif //ENGINE_UTILS_QUEUE_HPP
@@ -0,0 +1,179 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ENGINE_UTILS_SLOTMAP_HPP
+#define ENGINE_UTILS_SLOTMAP_HPP
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace engine::utils {
+	// A handle to an element in a SlotMap. The generation changes whenever a slot is reused, so a handle to an erased
+	// element will not resolve to a newer element that happens to occupy the same slot.
+	struct SlotHandle {
+	public:
+		std::uint32_t Index = 0;
+		std::uint32_t Generation = 0;
+
+		friend inline bool operator==(const SlotHandle& lhs, const SlotHandle& rhs) { return lhs.Index == rhs.Index && lhs.Generation == rhs.Generation; }
+		friend inline bool operator!=(const SlotHandle& lhs, const SlotHandle& rhs) { return !(lhs == rhs); }
+	};
+
+	// A container that gives out stable handles to its elements while storing the elements contiguously. Insertion,
+	// erasure, and lookup are all O(1), and iteration walks a densely packed array. Erasing an element moves the last
+	// element into its place, so pointers and iteration order are not stable across insertions and erasures.
+	// GenerationBits limits the size of the generation, for handles that must be packed into smaller integers. A
+	// smaller generation wraps around sooner, which makes it possible for a very old handle to become valid again.
+	template<typename T, unsigned GenerationBits = 32>
+	class SlotMap {
+	public:
+		SlotMap() = default;
+		SlotMap(std::size_t capacity);
+
+		// Adds the element and returns a handle that refers to it.
+		SlotHandle Insert(T value);
+		// Removes the element that the handle refers to. Returns false if the handle does not refer to an element.
+		bool Erase(SlotHandle handle);
+		// Returns a pointer to the element that the handle refers to, or a nullptr if the handle is stale. The pointer
+		// is invalidated by any insertion or erasure.
+		T* Get(SlotHandle handle);
+		// Returns a pointer to the element that the handle refers to, or a nullptr if the handle is stale. The pointer
+		// is invalidated by any insertion or erasure.
+		const T* Get(SlotHandle handle) const;
+		// Returns whether the handle refers to an element.
+		[[nodiscard]] bool Contains(SlotHandle handle) const;
+		// Returns the handle of the element at the given position in the dense storage.
+		[[nodiscard]] SlotHandle HandleAt(std::size_t denseIndex) const;
+		// Returns the number of elements.
+		[[nodiscard]] std::size_t Size() const;
+		// Removes all elements. All existing handles become stale.
+		void Clear();
+		// Reserves space for the given number of elements.
+		void Reserve(std::size_t capacity);
+
+		T* begin() { return dense.data(); }
+		T* end() { return dense.data() + dense.size(); }
+		const T* begin() const { return dense.data(); }
+		const T* end() const { return dense.data() + dense.size(); }
+
+	private:
+		struct slot {
+		public:
+			// While occupied, this is the element's position in the dense storage. While free, this is the next free slot.
+			std::uint32_t DenseIndexOrNextFree;
+			std::uint32_t Generation;
+		};
+
+		static constexpr std::uint32_t noFreeSlot = std::numeric_limits<std::uint32_t>::max();
+		static constexpr std::uint32_t generationMask = (GenerationBits >= 32) ? std::numeric_limits<std::uint32_t>::max() : ((std::uint32_t(1) << GenerationBits) - 1);
+
+		std::vector<T> dense;
+		std::vector<std::uint32_t> denseToSlot;
+		std::vector<slot> slots;
+		std::uint32_t freeHead = noFreeSlot;
+
+		static_assert(GenerationBits > 0 && GenerationBits <= 32, "GenerationBits must be between 1 and 32");
+	};
+
+	template<typename T, unsigned GenerationBits>
+	SlotMap<T, GenerationBits>::SlotMap(std::size_t capacity) {
+		Reserve(capacity);
+	}
+
+	template<typename T, unsigned GenerationBits>
+	SlotHandle SlotMap<T, GenerationBits>::Insert(T value) {
+		std::uint32_t slotIndex;
+		if (freeHead != noFreeSlot) {
+			slotIndex = freeHead;
+			freeHead = slots[slotIndex].DenseIndexOrNextFree;
+		} else {
+			slotIndex = (std::uint32_t)slots.size();
+			slots.push_back(slot{.DenseIndexOrNextFree = 0, .Generation = 0});
+		}
+		slots[slotIndex].DenseIndexOrNextFree = (std::uint32_t)dense.size();
+		dense.push_back(std::move(value));
+		denseToSlot.push_back(slotIndex);
+		return SlotHandle{.Index = slotIndex, .Generation = slots[slotIndex].Generation};
+	}
+
+	template<typename T, unsigned GenerationBits>
+	bool SlotMap<T, GenerationBits>::Erase(SlotHandle handle) {
+		if (!Contains(handle)) {
+			return false;
+		}
+		slot& erasedSlot = slots[handle.Index];
+		std::uint32_t denseIndex = erasedSlot.DenseIndexOrNextFree;
+		std::uint32_t lastIndex = (std::uint32_t)dense.size() - 1;
+		if (denseIndex != lastIndex) {
+			// Swapping rather than move-assigning ensures that the erased element is destroyed by its own destructor
+			std::swap(dense[denseIndex], dense[lastIndex]);
+			denseToSlot[denseIndex] = denseToSlot[lastIndex];
+			slots[denseToSlot[denseIndex]].DenseIndexOrNextFree = denseIndex;
+		}
+		dense.pop_back();
+		denseToSlot.pop_back();
+		erasedSlot.Generation = (erasedSlot.Generation + 1) & generationMask;
+		erasedSlot.DenseIndexOrNextFree = freeHead;
+		freeHead = handle.Index;
+		return true;
+	}
+
+	template<typename T, unsigned GenerationBits>
+	T* SlotMap<T, GenerationBits>::Get(SlotHandle handle) {
+		if (!Contains(handle)) {
+			return nullptr;
+		}
+		return &dense[slots[handle.Index].DenseIndexOrNextFree];
+	}
+
+	template<typename T, unsigned GenerationBits>
+	const T* SlotMap<T, GenerationBits>::Get(SlotHandle handle) const {
+		if (!Contains(handle)) {
+			return nullptr;
+		}
+		return &dense[slots[handle.Index].DenseIndexOrNextFree];
+	}
+
+	template<typename T, unsigned GenerationBits>
+	bool SlotMap<T, GenerationBits>::Contains(SlotHandle handle) const {
+		if (handle.Index >= slots.size()) {
+			return false;
+		}
+		const slot& s = slots[handle.Index];
+		// Checking the reverse mapping rejects free slots whose generation has wrapped around to match the handle
+		return s.Generation == handle.Generation && s.DenseIndexOrNextFree < dense.size() && denseToSlot[s.DenseIndexOrNextFree] == handle.Index;
+	}
+
+	template<typename T, unsigned GenerationBits>
+	SlotHandle SlotMap<T, GenerationBits>::HandleAt(std::size_t denseIndex) const {
+		std::uint32_t slotIndex = denseToSlot[denseIndex];
+		return SlotHandle{.Index = slotIndex, .Generation = slots[slotIndex].Generation};
+	}
+
+	template<typename T, unsigned GenerationBits>
+	std::size_t SlotMap<T, GenerationBits>::Size() const {
+		return dense.size();
+	}
+
+	template<typename T, unsigned GenerationBits>
+	void SlotMap<T, GenerationBits>::Clear() {
+		// Erasing from the back avoids moving any elements
+		while (!dense.empty()) {
+			Erase(HandleAt(dense.size() - 1));
+		}
+	}
+
+	template<typename T, unsigned GenerationBits>
+	void SlotMap<T, GenerationBits>::Reserve(std::size_t capacity) {
+		dense.reserve(capacity);
+		denseToSlot.reserve(capacity);
+		slots.reserve(capacity);
+	}
+}
+
+#endif //ENGINE_UTILS_SLOTMAP_HPP
@@ -9,7 +9,9 @@
 
 #include <engine/utils/freelist.hpp>
 #include <engine/utils/memorypool.hpp>
+#include <engine/utils/queue.hpp>
 #include <engine/utils/rollingaverage.hpp>
+#include <engine/utils/slotmap.hpp>
 #include <engine/utils/textureatlas.hpp>
 
 #endif //ENGINE_UTILS_UTILS_HPP
@@ -8,5 +8,5 @@
 #include <engine/backend/common.hpp>
 
 double engine::Application::GetElapsedTime() {
-	return commonImpl->guiBackend->GetElapsedTime();
+	return commonImpl->GetElapsedTime();
 }
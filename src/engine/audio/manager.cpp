@@ -11,7 +11,6 @@
 #define MINIAUDIO_IMPLEMENTATION
 #include <miniaudio/miniaudio.h>
 #include <iostream>
-#include <unordered_set>
 
 // VFS Implementation --------------------------------------------------------------------------------------------------
 
@@ -173,11 +172,13 @@ ma_result onInfo(ma_vfs* vfs, ma_vfs_file file, ma_file_info* info) {
 class engine::audio::Manager::soundGroupImpl {
 public:
 	soundGroupImpl(ma_engine* baseEngine, ma_uint32 flags, SoundGroup parent, ma_sound_group* parentGroup);
+	soundGroupImpl(soundGroupImpl&& other) noexcept = default;
+	soundGroupImpl& operator=(soundGroupImpl&& other) noexcept = default;
 	~soundGroupImpl();
 	void SetVolume(float volume);
 	std::unique_ptr<ma_sound_group> MaSoundGroup;
 	SoundGroup Parent;
-	std::unordered_set<SoundGroup> Children;
+	std::vector<SoundGroup> Children;
 };
 
 engine::audio::Manager::soundGroupImpl::soundGroupImpl(ma_engine* baseEngine, ma_uint32 flags, SoundGroup parent, ma_sound_group* parentGroup) {
@@ -193,7 +194,10 @@ engine::audio::Manager::soundGroupImpl::soundGroupImpl(ma_engine* baseEngine, ma
 	this->Parent = parent;
 }
 engine::audio::Manager::soundGroupImpl::~soundGroupImpl() {
-	ma_sound_group_uninit(MaSoundGroup.get());
+	// Sound groups are moved around within the slot map, so only the instance that still owns the group uninitializes it
+	if (MaSoundGroup) {
+		ma_sound_group_uninit(MaSoundGroup.get());
+	}
 };
 
 void engine::audio::Manager::soundGroupImpl::SetVolume(float volume) {
@@ -242,13 +246,15 @@ engine::audio::Manager::privateImpl::~privateImpl() {
 
 engine::audio::Manager::Manager(engine::fs::IFileSystem* vfs) {
 	impl = std::make_unique<privateImpl>(vfs);
-	soundGroups[0] = new soundGroupImpl(impl->miniAudioEngine.get(), 0, 0, nullptr);
+	// The master sound group is the first group inserted, which gives it the default constructed handle
+	auto master = soundGroups.Insert(soundGroupImpl(impl->miniAudioEngine.get(), 0, SoundGroup{}, nullptr));
+	assert(master == GetMasterSoundGroup());
 	listener = std::unique_ptr<Listener>(new Listener(impl->miniAudioEngine.get(), glm::vec3(0)));
 }
 
 engine::audio::Manager::~Manager() {
-	deleteSoundGroup(0);
-	assert(soundGroups.empty());
+	deleteSoundGroup(GetMasterSoundGroup());
+	assert(soundGroups.Size() == 0);
 };
 
 std::unique_ptr<engine::audio::Sound> engine::audio::Manager::LoadMusic(
@@ -257,16 +263,8 @@ std::unique_ptr<engine::audio::Sound> engine::audio::Manager::LoadMusic(
 	bool streamFromFile,
 	bool loop) {
 	std::unique_ptr<Sound> sound(new Sound(impl->miniAudioEngine.get()));
-	ma_sound_group* maSoundGroup;
-	auto soundGroupImplIter = soundGroups.find(soundGroup);
-	if (soundGroupImplIter == soundGroups.end()) {
-		engine::log::Debug("Failed to find sound group %d. Assigning to master", soundGroup);
-		maSoundGroup = soundGroups[0]->MaSoundGroup.get();
-	} else {
-		maSoundGroup = soundGroupImplIter->second->MaSoundGroup.get();
-	}
 	if (!sound->init(filePath,
-					 maSoundGroup,
+					 getMaSoundGroup(soundGroup),
 					 streamFromFile,
 					 false,
 					 loop)) {
@@ -281,16 +279,8 @@ std::unique_ptr<engine::audio::Sound> engine::audio::Manager::LoadSoundEffect(
 	bool streamFromFile,
 	bool loop) {
 	std::unique_ptr<Sound> sound(new Sound(impl->miniAudioEngine.get()));
-	ma_sound_group* maSoundGroup;
-	auto soundGroupImplIter = soundGroups.find(soundGroup);
-	if (soundGroupImplIter == soundGroups.end()) {
-		engine::log::Debug("Failed to find sound group %d. Assigning to master", soundGroup);
-		maSoundGroup = soundGroups[0]->MaSoundGroup.get();
-	} else {
-		maSoundGroup = soundGroupImplIter->second->MaSoundGroup.get();
-	}
 	if (!sound->init(filePath,
-					 maSoundGroup,
+					 getMaSoundGroup(soundGroup),
 					 streamFromFile,
 					 false,
 					 loop)) {
@@ -305,16 +295,8 @@ std::unique_ptr<engine::audio::PositionalSound> engine::audio::Manager::LoadPosi
 	bool streamFromFile,
 	bool loop) {
 	std::unique_ptr<PositionalSound> sound(new PositionalSound(impl->miniAudioEngine.get(), glm::vec3(0)));
-	ma_sound_group* maSoundGroup;
-	auto soundGroupImplIter = soundGroups.find(soundGroup);
-	if (soundGroupImplIter == soundGroups.end()) {
-		engine::log::Debug("Failed to find sound group %d. Assigning to master", soundGroup);
-		maSoundGroup = soundGroups[0]->MaSoundGroup.get();
-	} else {
-		maSoundGroup = soundGroupImplIter->second->MaSoundGroup.get();
-	}
 	if (!sound->init(filePath,
-					 maSoundGroup,
+					 getMaSoundGroup(soundGroup),
 					 streamFromFile,
 					 true,
 					 loop)) {
@@ -328,67 +310,65 @@ engine::audio::Listener* engine::audio::Manager::GetListener() {
 }
 
 engine::audio::SoundGroup engine::audio::Manager::GetMasterSoundGroup() {
-	return 0;
+	return SoundGroup{};
 }
 
 engine::audio::SoundGroup engine::audio::Manager::CreateSoundGroup(engine::audio::SoundGroup parentGroup) {
-	ma_sound_group* baseParentGroup = nullptr;
-	auto parentImpl = soundGroups.find(parentGroup);
-	if (parentImpl != soundGroups.end()) {
-		baseParentGroup = parentImpl->second->MaSoundGroup.get();
-	} else {
-		baseParentGroup = soundGroups.find(0)->second->MaSoundGroup.get();
+	if (!soundGroups.Contains(parentGroup)) {
+		parentGroup = GetMasterSoundGroup();
 	}
-
-	auto sgImpl = new soundGroupImpl(impl->miniAudioEngine.get(), 0, parentGroup, baseParentGroup);
-	int sgID = nextSoundGroupID++;
-	soundGroups[sgID] = sgImpl;
-	parentImpl->second->Children.insert(sgID);
-
+	auto sgID = soundGroups.Insert(soundGroupImpl(impl->miniAudioEngine.get(), 0, parentGroup, soundGroups.Get(parentGroup)->MaSoundGroup.get()));
+	// Inserting may move the parent within the map, so we look it up again afterward
+	soundGroups.Get(parentGroup)->Children.push_back(sgID);
 	return sgID;
 }
 
+void* engine::audio::Manager::getMaSoundGroup(engine::audio::SoundGroup soundGroup) {
+	auto group = soundGroups.Get(soundGroup);
+	if (!group) {
+		engine::log::Debug("Failed to find sound group %u. Assigning to master", soundGroup.Index);
+		group = soundGroups.Get(GetMasterSoundGroup());
+	}
+	return group->MaSoundGroup.get();
+}
+
 void engine::audio::Manager::deleteSoundGroupChildren(engine::audio::SoundGroup soundGroup) {
 	// don't delete if not found
-	auto group = soundGroups.find(soundGroup);
-	if (group == soundGroups.end()) {
+	auto group = soundGroups.Get(soundGroup);
+	if (!group) {
 		return;
 	}
 
-	// delete children
-	for (SoundGroup child: group->second->Children) {
+	// delete children, taking the list first as erasing children may move this group within the map
+	auto children = std::move(group->Children);
+	for (SoundGroup child: children) {
 		deleteSoundGroupChildren(child);
 	}
 
 	// clear memory
-	delete group->second;
-	soundGroups.erase(soundGroup);
+	soundGroups.Erase(soundGroup);
 }
 
 void engine::audio::Manager::deleteSoundGroup(engine::audio::SoundGroup soundGroup) {
 	// don't delete if not found
-	auto group = soundGroups.find(soundGroup);
-	if (group == soundGroups.end()) {
+	auto group = soundGroups.Get(soundGroup);
+	if (!group) {
 		return;
 	}
+	SoundGroup parent = group->Parent;
 
-	// delete children
-	for (SoundGroup child: group->second->Children) {
-		deleteSoundGroupChildren(child);
-	}
+	// delete children and clear memory
+	deleteSoundGroupChildren(soundGroup);
 
 	// remove from parent
-	auto parentGroup = soundGroups.find(group->second->Parent);
-	parentGroup->second->Children.erase(soundGroup);
-
-	// clear memory
-	delete group->second;
-	soundGroups.erase(soundGroup);
+	if (auto parentGroup = soundGroups.Get(parent)) {
+		std::erase(parentGroup->Children, soundGroup);
+	}
 }
 
 void engine::audio::Manager::DeleteSoundGroup(engine::audio::SoundGroup soundGroup) {
 	// don't delete master
-	if (soundGroup == 0) {
+	if (soundGroup == GetMasterSoundGroup()) {
 		return;
 	}
 
@@ -396,9 +376,9 @@ void engine::audio::Manager::DeleteSoundGroup(engine::audio::SoundGroup soundGro
 }
 
 void engine::audio::Manager::SetVolume(float volume, engine::audio::SoundGroup soundGroup) {
-	auto group = soundGroups.find(soundGroup);
-	if (group == soundGroups.end()) {
+	auto group = soundGroups.Get(soundGroup);
+	if (!group) {
 		return;
 	}
-	group->second->SetVolume(volume);
+	group->SetVolume(volume);
 }
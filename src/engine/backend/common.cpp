@@ -5,6 +5,7 @@
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
 #include <engine/backend/common.hpp>
+#include <engine/jobs/manager.hpp>
 #include <engine/physics/manager.hpp>
 #include <engine/graphics/manager.hpp>
 #include <engine/log/log.hpp>
@@ -23,19 +24,36 @@ engine::Application::~Application() {
 
 engine::Application::CommonImplementation::CommonImplementation(Application* app) {
 	this->application = app;
+#ifndef ENGINE_HEADLESS
 	guiBackend = std::make_unique<engine::gui::Backend>();
 	guiRenderer = std::make_unique<engine::gui::Renderer>();
+#endif //ENGINE_HEADLESS
 }
 
 engine::Application::CommonImplementation::~CommonImplementation() {
+#ifndef ENGINE_HEADLESS
 	Rml::Shutdown();
 	guiRenderer.reset();
 	guiBackend.reset();
 	engine::graphics::Terminate();
+#endif //ENGINE_HEADLESS
 	engine::physics::Terminate();
+	engine::jobs::Terminate();
 }
 
 bool engine::Application::CommonImplementation::Initialize() {
+	// Initialize the job system, which must exist before any other system that submits jobs
+	engine::jobs::Initialize();
+
+#ifdef ENGINE_HEADLESS
+	// Headless builds only run the application and physics, so there is no window, renderer, GUI or audio to create
+	double tickRate = application->StartOptions().TickRate;
+	if (tickRate > 0.0) {
+		tickTime = 1.0 / tickRate;
+	} else {
+		engine::log::Error("Tick rate must be greater than zero, using the default of 60");
+	}
+#else
 	// Create the window
 	if (!application->platImpl->InitializeWindow()) {
 		return false;
@@ -65,12 +83,15 @@ bool engine::Application::CommonImplementation::Initialize() {
 		engine::log::Error("Unable to create GUI context");
 		return false;
 	}
+#endif //ENGINE_HEADLESS
 
 	// Initialize physics
 	engine::physics::Initialize(application);
 
+#ifndef ENGINE_HEADLESS
 	// Initialize audio
 	application->audioManager = std::make_unique<engine::audio::Manager>(new engine::fs::NativeFileSystem());
+#endif //ENGINE_HEADLESS
 
 	// Initialize input
 	if (!application->platImpl->InitializeInput()) {
@@ -88,7 +109,7 @@ bool engine::Application::CommonImplementation::Initialize() {
 bool engine::Application::CommonImplementation::UpdateLoop() {
 	// The frame start time is used to check how long a frame has taken, which will determine if we need to limit the
 	// framerate. When the framerate is too high, unintended behavior occurs, so we force a cap.
-	double frameStartTime = guiBackend->GetElapsedTime();
+	double frameStartTime = GetElapsedTime();
 
 	application->inputHandler->Update();
 	if (!application->platImpl->ProcessMessages()) {
@@ -99,10 +120,17 @@ bool engine::Application::CommonImplementation::UpdateLoop() {
 	}
 
 	// The delta time reports the time since the last check, so that events may properly update their logic
-	double currentTime = guiBackend->GetElapsedTime();
+	double currentTime = GetElapsedTime();
 	double deltaTime = currentTime - lastRecordedTime;
 	lastRecordedTime = currentTime;
 
+#ifdef ENGINE_HEADLESS
+	if (!application->Update(deltaTime)) {
+		return false;
+	}
+	engine::physics::Update(deltaTime);
+	application->platImpl->WaitFor(tickTime - (GetElapsedTime() - frameStartTime));
+#else
 	engine::graphics::GlobalManager->NewFrame(deltaTime);
 	if (!application->platImpl->ImGuiNewFrame()) {
 		return false;
@@ -123,7 +151,8 @@ bool engine::Application::CommonImplementation::UpdateLoop() {
 	}
 	guiRenderer->FrameEnd();
 	engine::graphics::GlobalManager->EndFrame();
-	application->platImpl->WaitFor(engine::graphics::GlobalManager->GetMinimumFrameTime() - (guiBackend->GetElapsedTime() - frameStartTime));
+	application->platImpl->WaitFor(engine::graphics::GlobalManager->GetMinimumFrameTime() - (GetElapsedTime() - frameStartTime));
+#endif //ENGINE_HEADLESS
 	return true;
 }
 
@@ -134,3 +163,11 @@ void engine::Application::CommonImplementation::HandleResize(std::uint32_t width
 		application->rmlContext->SetDimensions(Rml::Vector2i((int)width, (int)height));
 	}
 }
+
+double engine::Application::CommonImplementation::GetElapsedTime() {
+#ifdef ENGINE_HEADLESS
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+#else
+	return guiBackend->GetElapsedTime();
+#endif //ENGINE_HEADLESS
+}
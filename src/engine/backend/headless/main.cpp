@@ -0,0 +1,104 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifdef ENGINE_HEADLESS
+
+#include <engine/backend/headless.hpp>
+#include <engine/log/log.hpp>
+#include <chrono>
+#include <csignal>
+#include <thread>
+
+// Set by the signal handler, so that interrupting or terminating a server shuts the application down cleanly
+static volatile std::sig_atomic_t stopRequested = 0;
+
+static void handleStopSignal(int) {
+	stopRequested = 1;
+}
+
+engine::Application::PlatformImplementation::PlatformCallbacks::PlatformCallbacks(engine::Application::CommonImplementation* commonImpl) {}
+
+engine::Application::PlatformImplementation::PlatformCallbacks::~PlatformCallbacks() = default;
+
+engine::Application::PlatformImplementation::PlatformImplementation(engine::Application* app) {
+	application = app;
+	application->platImpl.reset(this);
+	this->Data = std::make_unique<engine::Application::PlatformImplementation::PlatformData>();
+	this->Callbacks = std::make_unique<engine::Application::PlatformImplementation::PlatformCallbacks>(application->commonImpl.get());
+}
+
+engine::Application::PlatformImplementation::~PlatformImplementation() = default;
+
+engine::Application::CommonImplementation* engine::Application::PlatformImplementation::GetCommonImplementation() {
+	return application->commonImpl.get();
+}
+
+bool engine::Application::PlatformImplementation::InitializeWindow() {
+	return true;
+}
+
+bool engine::Application::PlatformImplementation::InitializeInput() {
+	// No devices are connected, so the input handler reports no keyboards, mice or gamepads
+	return true;
+}
+
+bool engine::Application::PlatformImplementation::SetGUIBackend() {
+	return true;
+}
+
+bool engine::Application::PlatformImplementation::ProcessMessages() {
+	return stopRequested == 0;
+}
+
+bool engine::Application::PlatformImplementation::UpdateInput() {
+	return true;
+}
+
+void* engine::Application::PlatformImplementation::GetWindowHandle() const {
+	return nullptr;
+}
+
+bool engine::Application::PlatformImplementation::ImGuiInitialize() {
+	return true;
+}
+
+bool engine::Application::PlatformImplementation::ImGuiNewFrame() {
+	return true;
+}
+
+void engine::Application::PlatformImplementation::ImGuiShutdown() {}
+
+void engine::Application::PlatformImplementation::WaitFor(double seconds) {
+	// Servers tick far slower than a renderer, so the scheduler's precision is enough and the thread is left idle
+	if (seconds > 0.0) {
+		std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+	}
+}
+
+void engine::input::Handler::SetMouseCaptureState(Mouse::CaptureState state) {
+	// There is no cursor to capture, so the state is only recorded
+	mouseCaptureState = state;
+}
+
+int main(int argc, char** argv) {
+	std::signal(SIGINT, handleStopSignal);
+	std::signal(SIGTERM, handleStopSignal);
+
+	auto application = std::unique_ptr<engine::Application>(engine::NewApplication());
+	auto platImpl = new engine::Application::PlatformImplementation(application.get());
+
+	auto commonImpl = platImpl->GetCommonImplementation();
+	if (!commonImpl->Initialize()) {
+		return 1;
+	}
+
+	while (commonImpl->UpdateLoop()) {}
+	application->Shutdown();
+
+	return 0;
+}
+
+#endif //ENGINE_HEADLESS
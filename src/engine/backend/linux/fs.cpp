@@ -0,0 +1,25 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifdef PLATFORM_LINUX
+
+#include <engine/fs/fs.hpp>
+#include <limits.h>
+#include <unistd.h>
+
+std::filesystem::path engine::fs::GetDirectoryWithExecutable() {
+	char path[PATH_MAX] = {0};
+	ssize_t length = readlink("/proc/self/exe", path, sizeof(path) - 1);
+	if (length <= 0) {
+		return "";
+	}
+	path[length] = '\0';
+	std::filesystem::path result = path;
+	result = result.parent_path();
+	return result;
+}
+
+#endif //PLATFORM_LINUX
@@ -0,0 +1,224 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#if defined(PLATFORM_LINUX) && !defined(ENGINE_HEADLESS)
+
+#include <engine/backend/linux.hpp>
+#include <X11/keysym.h>
+#include <cfloat>
+#include <imgui.h>
+
+// ImGui does not ship an Xlib platform backend, so events are fed to ImGui from here using its input queue.
+
+ImGuiKey ToImGuiKey(KeySym keysym) {
+	if (keysym >= XK_a && keysym <= XK_z) {
+		return (ImGuiKey)(ImGuiKey_A + (keysym - XK_a));
+	} else if (keysym >= XK_A && keysym <= XK_Z) {
+		return (ImGuiKey)(ImGuiKey_A + (keysym - XK_A));
+	} else if (keysym >= XK_0 && keysym <= XK_9) {
+		return (ImGuiKey)(ImGuiKey_0 + (keysym - XK_0));
+	} else if (keysym >= XK_F1 && keysym <= XK_F12) {
+		return (ImGuiKey)(ImGuiKey_F1 + (keysym - XK_F1));
+	} else if (keysym >= XK_KP_0 && keysym <= XK_KP_9) {
+		return (ImGuiKey)(ImGuiKey_Keypad0 + (keysym - XK_KP_0));
+	}
+	switch (keysym) {
+		case XK_Tab:
+		case XK_ISO_Left_Tab:
+			return ImGuiKey_Tab;
+		case XK_Left:
+			return ImGuiKey_LeftArrow;
+		case XK_Right:
+			return ImGuiKey_RightArrow;
+		case XK_Up:
+			return ImGuiKey_UpArrow;
+		case XK_Down:
+			return ImGuiKey_DownArrow;
+		case XK_Page_Up:
+			return ImGuiKey_PageUp;
+		case XK_Page_Down:
+			return ImGuiKey_PageDown;
+		case XK_Home:
+			return ImGuiKey_Home;
+		case XK_End:
+			return ImGuiKey_End;
+		case XK_Insert:
+			return ImGuiKey_Insert;
+		case XK_Delete:
+			return ImGuiKey_Delete;
+		case XK_BackSpace:
+			return ImGuiKey_Backspace;
+		case XK_space:
+			return ImGuiKey_Space;
+		case XK_Return:
+			return ImGuiKey_Enter;
+		case XK_KP_Enter:
+			return ImGuiKey_KeypadEnter;
+		case XK_Escape:
+			return ImGuiKey_Escape;
+		case XK_apostrophe:
+			return ImGuiKey_Apostrophe;
+		case XK_comma:
+			return ImGuiKey_Comma;
+		case XK_minus:
+			return ImGuiKey_Minus;
+		case XK_period:
+			return ImGuiKey_Period;
+		case XK_slash:
+			return ImGuiKey_Slash;
+		case XK_semicolon:
+			return ImGuiKey_Semicolon;
+		case XK_equal:
+			return ImGuiKey_Equal;
+		case XK_bracketleft:
+			return ImGuiKey_LeftBracket;
+		case XK_backslash:
+			return ImGuiKey_Backslash;
+		case XK_bracketright:
+			return ImGuiKey_RightBracket;
+		case XK_grave:
+			return ImGuiKey_GraveAccent;
+		case XK_Caps_Lock:
+			return ImGuiKey_CapsLock;
+		case XK_Scroll_Lock:
+			return ImGuiKey_ScrollLock;
+		case XK_Num_Lock:
+			return ImGuiKey_NumLock;
+		case XK_Print:
+			return ImGuiKey_PrintScreen;
+		case XK_Pause:
+			return ImGuiKey_Pause;
+		case XK_Shift_L:
+			return ImGuiKey_LeftShift;
+		case XK_Control_L:
+			return ImGuiKey_LeftCtrl;
+		case XK_Alt_L:
+			return ImGuiKey_LeftAlt;
+		case XK_Super_L:
+			return ImGuiKey_LeftSuper;
+		case XK_Shift_R:
+			return ImGuiKey_RightShift;
+		case XK_Control_R:
+			return ImGuiKey_RightCtrl;
+		case XK_Alt_R:
+			return ImGuiKey_RightAlt;
+		case XK_Super_R:
+			return ImGuiKey_RightSuper;
+		case XK_Menu:
+			return ImGuiKey_Menu;
+		default:
+			return ImGuiKey_None;
+	}
+}
+
+// Feeds the event to ImGui, returning true when ImGui is using the mouse or keyboard that the event came from. The
+// key's symbol and text are looked up by the message handler, as the input context may only look up each key once.
+bool ImGuiX11EventHandler(const XEvent& event, KeySym keysym, const char* text) {
+	if (ImGui::GetCurrentContext() == nullptr) {
+		return false;
+	}
+	ImGuiIO& io = ImGui::GetIO();
+	switch (event.type) {
+		case MotionNotify:
+			io.AddMousePosEvent((float)event.xmotion.x, (float)event.xmotion.y);
+			return false;
+		case LeaveNotify:
+			if (event.xcrossing.mode == NotifyNormal) {
+				io.AddMousePosEvent(-FLT_MAX, -FLT_MAX);
+			}
+			return false;
+		case ButtonPress:
+		case ButtonRelease: {
+			bool isDown = event.type == ButtonPress;
+			switch (event.xbutton.button) {
+				case Button1:
+					io.AddMouseButtonEvent(0, isDown);
+					break;
+				case Button2:
+					io.AddMouseButtonEvent(2, isDown);
+					break;
+				case Button3:
+					io.AddMouseButtonEvent(1, isDown);
+					break;
+				case Button4:
+					if (isDown) {
+						io.AddMouseWheelEvent(0.0f, 1.0f);
+					}
+					break;
+				case Button5:
+					if (isDown) {
+						io.AddMouseWheelEvent(0.0f, -1.0f);
+					}
+					break;
+				case 6:
+					if (isDown) {
+						io.AddMouseWheelEvent(1.0f, 0.0f);
+					}
+					break;
+				case 7:
+					if (isDown) {
+						io.AddMouseWheelEvent(-1.0f, 0.0f);
+					}
+					break;
+				default:
+					break;
+			}
+			return io.WantCaptureMouse;
+		}
+		case KeyPress:
+		case KeyRelease: {
+			bool isDown = event.type == KeyPress;
+			unsigned int state = event.xkey.state;
+#if IMGUI_VERSION_NUM >= 18900
+			io.AddKeyEvent(ImGuiMod_Ctrl, (state & ControlMask) != 0);
+			io.AddKeyEvent(ImGuiMod_Shift, (state & ShiftMask) != 0);
+			io.AddKeyEvent(ImGuiMod_Alt, (state & Mod1Mask) != 0);
+			io.AddKeyEvent(ImGuiMod_Super, (state & Mod4Mask) != 0);
+#else
+			io.AddKeyEvent(ImGuiKey_ModCtrl, (state & ControlMask) != 0);
+			io.AddKeyEvent(ImGuiKey_ModShift, (state & ShiftMask) != 0);
+			io.AddKeyEvent(ImGuiKey_ModAlt, (state & Mod1Mask) != 0);
+			io.AddKeyEvent(ImGuiKey_ModSuper, (state & Mod4Mask) != 0);
+#endif
+			ImGuiKey key = ToImGuiKey(keysym);
+			if (key != ImGuiKey_None) {
+				io.AddKeyEvent(key, isDown);
+			}
+			if (isDown && text && (state & (ControlMask | Mod1Mask)) == 0) {
+				io.AddInputCharactersUTF8(text);
+			}
+			return io.WantCaptureKeyboard;
+		}
+		case FocusIn:
+		case FocusOut:
+			if (event.xfocus.mode == NotifyNormal || event.xfocus.mode == NotifyWhileGrabbed) {
+				io.AddFocusEvent(event.type == FocusIn);
+			}
+			return false;
+		default:
+			return false;
+	}
+}
+
+bool engine::Application::PlatformImplementation::ImGuiInitialize() {
+	ImGuiIO& io = ImGui::GetIO();
+	io.BackendPlatformName = "galactic_engine_x11";
+	io.DisplaySize = ImVec2((float)Data->Width, (float)Data->Height);
+	return true;
+}
+
+bool engine::Application::PlatformImplementation::ImGuiNewFrame() {
+	ImGui::GetIO().DisplaySize = ImVec2((float)Data->Width, (float)Data->Height);
+	return true;
+}
+
+void engine::Application::PlatformImplementation::ImGuiShutdown() {
+	if (ImGui::GetCurrentContext() != nullptr) {
+		ImGui::GetIO().BackendPlatformName = nullptr;
+	}
+}
+
+#endif //PLATFORM_LINUX && !ENGINE_HEADLESS
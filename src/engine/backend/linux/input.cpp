@@ -0,0 +1,265 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#if defined(PLATFORM_LINUX) && !defined(ENGINE_HEADLESS)
+
+#include <engine/backend/linux.hpp>
+#include <engine/log/log.hpp>
+#include <linux/input.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <filesystem>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+// How often, in seconds, the input devices are scanned for newly connected gamepads
+static constexpr double GamepadScanInterval = 2.0;
+
+static bool hasBit(const unsigned long* bits, int bit) {
+	constexpr int bitsPerLong = sizeof(unsigned long) * 8;
+	return (bits[bit / bitsPerLong] >> (bit % bitsPerLong)) & 1UL;
+}
+
+// Maps the axis value onto [-1, 1] (or [0, 1] for triggers) using the range that the device reports for the axis.
+static float normalizeAxis(const engine::Application::PlatformImplementation::PlatformData::gamepadDevice& gamepad, int axis, int value, bool isTrigger) {
+	int minimum = gamepad.AxisMinimum[axis];
+	int maximum = gamepad.AxisMaximum[axis];
+	if (maximum <= minimum) {
+		return 0.0f;
+	}
+	float normalized = (float)(value - minimum) / (float)(maximum - minimum);
+	return isTrigger ? normalized : (normalized * 2.0f) - 1.0f;
+}
+
+// Opens any gamepads that are not already open. Only event devices that have both gamepad buttons and an analog stick
+// are treated as gamepads, which excludes keyboards, mice, and the motion sensors that some controllers expose.
+static void scanGamepads(engine::Application* application, engine::Application::PlatformImplementation::PlatformData* data) {
+	std::error_code ec;
+	for (const auto& entry: std::filesystem::directory_iterator("/dev/input", ec)) {
+		std::string path = entry.path().string();
+		if (entry.path().filename().string().rfind("event", 0) != 0) {
+			continue;
+		}
+		bool isOpen = false;
+		int freeSlot = -1;
+		for (int i = 0; i < 4; i++) {
+			if (data->Gamepads[i].File >= 0 && data->Gamepads[i].Path == path) {
+				isOpen = true;
+			} else if (data->Gamepads[i].File < 0 && freeSlot < 0) {
+				freeSlot = i;
+			}
+		}
+		if (isOpen || freeSlot < 0) {
+			continue;
+		}
+		int file = open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+		if (file < 0) {
+			continue;
+		}
+		unsigned long keyBits[KEY_MAX / (sizeof(unsigned long) * 8) + 1] = {};
+		unsigned long absBits[ABS_MAX / (sizeof(unsigned long) * 8) + 1] = {};
+		if (ioctl(file, EVIOCGBIT(EV_KEY, sizeof(keyBits)), keyBits) < 0 ||
+			ioctl(file, EVIOCGBIT(EV_ABS, sizeof(absBits)), absBits) < 0 ||
+			!hasBit(keyBits, BTN_GAMEPAD) || !hasBit(absBits, ABS_X)) {
+			close(file);
+			continue;
+		}
+
+		auto& gamepad = data->Gamepads[freeSlot];
+		gamepad.File = file;
+		gamepad.Path = path;
+		for (int axis = 0; axis < 0x40; axis++) {
+			input_absinfo info = {};
+			if (hasBit(absBits, axis) && ioctl(file, EVIOCGABS(axis), &info) >= 0) {
+				gamepad.AxisMinimum[axis] = info.minimum;
+				gamepad.AxisMaximum[axis] = info.maximum;
+			} else {
+				gamepad.AxisMinimum[axis] = 0;
+				gamepad.AxisMaximum[axis] = 0;
+			}
+		}
+		gamepad.LeftStick[0] = gamepad.LeftStick[1] = 0.0f;
+		gamepad.RightStick[0] = gamepad.RightStick[1] = 0.0f;
+		gamepad.GamepadSetter = application->inputHandler->ConnectGamepad();
+		char name[256] = {};
+		ioctl(file, EVIOCGNAME(sizeof(name) - 1), name);
+		engine::log::Debug("Connected gamepad \"%s\" from %s", name, path.c_str());
+	}
+}
+
+static void disconnectGamepad(engine::Application* application, engine::Application::PlatformImplementation::PlatformData::gamepadDevice& gamepad) {
+	engine::log::Debug("Disconnected gamepad from %s", gamepad.Path.c_str());
+	close(gamepad.File);
+	gamepad.File = -1;
+	gamepad.Path.clear();
+	if (gamepad.GamepadSetter) {
+		application->inputHandler->DisconnectDevice(gamepad.GamepadSetter->GetID());
+		gamepad.GamepadSetter.reset(nullptr);
+	}
+}
+
+bool engine::Application::PlatformImplementation::InitializeInput() {
+	scanGamepads(application, Data.get());
+	Data->NextGamepadScan = application->commonImpl->guiBackend->GetElapsedTime() + GamepadScanInterval;
+
+	Data->MouseSetter = application->inputHandler->ConnectMouse();
+	Data->KeyboardSetter = application->inputHandler->ConnectKeyboard();
+	return true;
+}
+
+bool engine::Application::PlatformImplementation::UpdateInput() {
+	auto elapsedTime = application->commonImpl->guiBackend->GetElapsedTime();
+	if (elapsedTime >= Data->NextGamepadScan) {
+		scanGamepads(application, Data.get());
+		Data->NextGamepadScan = elapsedTime + GamepadScanInterval;
+	}
+
+	for (auto& gamepad: Data->Gamepads) {
+		if (gamepad.File < 0) {
+			continue;
+		}
+		auto gamepadSetter = gamepad.GamepadSetter.get();
+		// Reference: https://www.kernel.org/doc/html/latest/input/gamepad.html
+		input_event events[64];
+		ssize_t bytesRead;
+		while ((bytesRead = read(gamepad.File, events, sizeof(events))) > 0) {
+			for (ssize_t i = 0; i < bytesRead / (ssize_t)sizeof(input_event); i++) {
+				const input_event& ev = events[i];
+				if (ev.type == EV_KEY) {
+					bool isDown = ev.value != 0;
+					switch (ev.code) {
+						case BTN_SOUTH:
+							gamepadSetter->SetButton(engine::input::Gamepad::Button::A, isDown, elapsedTime);
+							break;
+						case BTN_EAST:
+							gamepadSetter->SetButton(engine::input::Gamepad::Button::B, isDown, elapsedTime);
+							break;
+						case BTN_NORTH:
+							gamepadSetter->SetButton(engine::input::Gamepad::Button::Y, isDown, elapsedTime);
+							break;
+						case BTN_WEST:
+							gamepadSetter->SetButton(engine::input::Gamepad::Button::X, isDown, elapsedTime);
+							break;
+						case BTN_TL:
+							gamepadSetter->SetButton(engine::input::Gamepad::Button::LShoulder, isDown, elapsedTime);
+							break;
+						case BTN_TR:
+							gamepadSetter->SetButton(engine::input::Gamepad::Button::RShoulder, isDown, elapsedTime);
+							break;
+						case BTN_TL2: // Controllers without analog triggers report them as buttons
+							gamepadSetter->SetTrigger(engine::input::Gamepad::Trigger::Left, isDown ? 1.0f : 0.0f);
+							break;
+						case BTN_TR2:
+							gamepadSetter->SetTrigger(engine::input::Gamepad::Trigger::Right, isDown ? 1.0f : 0.0f);
+							break;
+						case BTN_THUMBL:
+							gamepadSetter->SetButton(engine::input::Gamepad::Button::LStick, isDown, elapsedTime);
+							break;
+						case BTN_THUMBR:
+							gamepadSetter->SetButton(engine::input::Gamepad::Button::RStick, isDown, elapsedTime);
+							break;
+						case BTN_START:
+							gamepadSetter->SetButton(engine::input::Gamepad::Button::Start, isDown, elapsedTime);
+							break;
+						case BTN_SELECT:
+							gamepadSetter->SetButton(engine::input::Gamepad::Button::Options, isDown, elapsedTime);
+							break;
+						case BTN_DPAD_LEFT:
+							gamepadSetter->SetButton(engine::input::Gamepad::Button::DPadLeft, isDown, elapsedTime);
+							break;
+						case BTN_DPAD_RIGHT:
+							gamepadSetter->SetButton(engine::input::Gamepad::Button::DPadRight, isDown, elapsedTime);
+							break;
+						case BTN_DPAD_UP:
+							gamepadSetter->SetButton(engine::input::Gamepad::Button::DPadUp, isDown, elapsedTime);
+							break;
+						case BTN_DPAD_DOWN:
+							gamepadSetter->SetButton(engine::input::Gamepad::Button::DPadDown, isDown, elapsedTime);
+							break;
+						default:
+							break;
+					}
+				} else if (ev.type == EV_ABS && ev.code < 0x40) {
+					// Stick Y axes point down on evdev, while the gamepad reports up as positive
+					switch (ev.code) {
+						case ABS_X:
+							gamepad.LeftStick[0] = normalizeAxis(gamepad, ev.code, ev.value, false);
+							gamepadSetter->SetStick(engine::input::Gamepad::Stick::Left, gamepad.LeftStick[0], gamepad.LeftStick[1]);
+							break;
+						case ABS_Y:
+							gamepad.LeftStick[1] = -normalizeAxis(gamepad, ev.code, ev.value, false);
+							gamepadSetter->SetStick(engine::input::Gamepad::Stick::Left, gamepad.LeftStick[0], gamepad.LeftStick[1]);
+							break;
+						case ABS_RX:
+							gamepad.RightStick[0] = normalizeAxis(gamepad, ev.code, ev.value, false);
+							gamepadSetter->SetStick(engine::input::Gamepad::Stick::Right, gamepad.RightStick[0], gamepad.RightStick[1]);
+							break;
+						case ABS_RY:
+							gamepad.RightStick[1] = -normalizeAxis(gamepad, ev.code, ev.value, false);
+							gamepadSetter->SetStick(engine::input::Gamepad::Stick::Right, gamepad.RightStick[0], gamepad.RightStick[1]);
+							break;
+						case ABS_Z:
+							gamepadSetter->SetTrigger(engine::input::Gamepad::Trigger::Left, normalizeAxis(gamepad, ev.code, ev.value, true));
+							break;
+						case ABS_RZ:
+							gamepadSetter->SetTrigger(engine::input::Gamepad::Trigger::Right, normalizeAxis(gamepad, ev.code, ev.value, true));
+							break;
+						case ABS_HAT0X: // Many controllers report the directional pad as a hat rather than as buttons
+							gamepadSetter->SetButton(engine::input::Gamepad::Button::DPadLeft, ev.value < 0, elapsedTime);
+							gamepadSetter->SetButton(engine::input::Gamepad::Button::DPadRight, ev.value > 0, elapsedTime);
+							break;
+						case ABS_HAT0Y:
+							gamepadSetter->SetButton(engine::input::Gamepad::Button::DPadUp, ev.value < 0, elapsedTime);
+							gamepadSetter->SetButton(engine::input::Gamepad::Button::DPadDown, ev.value > 0, elapsedTime);
+							break;
+						default:
+							break;
+					}
+				}
+			}
+		}
+		if (bytesRead < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+			disconnectGamepad(application, gamepad);
+		}
+	}
+
+	if (!Data->ReceivedMouseMove) {
+		Data->MouseSetter->SetDelta(0, 0);
+	}
+	Data->ReceivedMouseMove = false;
+
+	auto mouseCaptureState = application->inputHandler->GetMouseCaptureState();
+	if (mouseCaptureState == engine::input::Mouse::CaptureState::Hard) {
+		XWarpPointer(Data->XDisplay, 0L, Data->WindowHandle, 0, 0, 0, 0, (int)(Data->Width / 2), (int)(Data->Height / 2));
+		XFlush(Data->XDisplay);
+	}
+	return true;
+}
+
+void engine::input::Handler::SetMouseCaptureState(Mouse::CaptureState state) {
+	if (mouseCaptureState == state) {
+		return;
+	}
+	mouseCaptureState = state;
+	auto data = application->platImpl->Data.get();
+	if (!data->XDisplay) {
+		return;
+	}
+
+	XUngrabPointer(data->XDisplay, CurrentTime);
+	if (state != engine::input::Mouse::CaptureState::None) {
+		// Confining the pointer to the window is the equivalent of clipping the cursor to the client area
+		Cursor cursor = (state == engine::input::Mouse::CaptureState::Hard) ? data->HiddenCursor : 0L;
+		int result = XGrabPointer(data->XDisplay, data->WindowHandle, 1, ButtonPressMask | ButtonReleaseMask | PointerMotionMask,
+								  GrabModeAsync, GrabModeAsync, data->WindowHandle, cursor, CurrentTime);
+		if (result != GrabSuccess) {
+			engine::log::Debug("Unable to capture the mouse (%d)", result);
+		}
+	}
+	XFlush(data->XDisplay);
+}
+
+#endif //PLATFORM_LINUX && !ENGINE_HEADLESS
@@ -0,0 +1,68 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#if defined(PLATFORM_LINUX) && !defined(ENGINE_HEADLESS)
+
+#include <engine/backend/linux.hpp>
+#include <engine/log/log.hpp>
+#include <unistd.h>
+
+engine::Application::PlatformImplementation::PlatformImplementation(engine::Application* app) {
+	application = app;
+	application->platImpl.reset(this);
+	this->Data = std::make_unique<engine::Application::PlatformImplementation::PlatformData>();
+	this->Callbacks = std::make_unique<engine::Application::PlatformImplementation::PlatformCallbacks>(application->commonImpl.get());
+}
+
+engine::Application::PlatformImplementation::~PlatformImplementation() {
+	for (auto& gamepad: Data->Gamepads) {
+		if (gamepad.File >= 0) {
+			close(gamepad.File);
+		}
+	}
+	if (Data->XDisplay) {
+		if (Data->InputContext) {
+			XDestroyIC(Data->InputContext);
+		}
+		if (Data->InputMethod) {
+			XCloseIM(Data->InputMethod);
+		}
+		if (Data->HiddenCursor) {
+			XFreeCursor(Data->XDisplay, Data->HiddenCursor);
+		}
+		if (Data->WindowHandle) {
+			XDestroyWindow(Data->XDisplay, Data->WindowHandle);
+		}
+		XCloseDisplay(Data->XDisplay);
+	}
+}
+
+engine::Application::CommonImplementation* engine::Application::PlatformImplementation::GetCommonImplementation() {
+	return application->commonImpl.get();
+}
+
+int main(int argc, char** argv) {
+	// The renderer presents from its own thread, so Xlib must be made thread-safe before any other call
+	if (!XInitThreads()) {
+		engine::log::Error("Unable to initialize Xlib for multiple threads");
+		return 1;
+	}
+
+	auto application = std::unique_ptr<engine::Application>(engine::NewApplication());
+	auto platImpl = new engine::Application::PlatformImplementation(application.get());
+
+	auto commonImpl = platImpl->GetCommonImplementation();
+	if (!commonImpl->Initialize()) {
+		return 1;
+	}
+
+	while (commonImpl->UpdateLoop()) {}
+	application->Shutdown();
+
+	return 0;
+}
+
+#endif //PLATFORM_LINUX && !ENGINE_HEADLESS
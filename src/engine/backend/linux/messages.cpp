@@ -0,0 +1,475 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#if defined(PLATFORM_LINUX) && !defined(ENGINE_HEADLESS)
+
+#include <engine/backend/linux.hpp>
+#include <X11/keysym.h>
+
+engine::Application::PlatformImplementation::PlatformCallbacks* callbackImpl = nullptr;
+engine::Application::CommonImplementation* commonImpl = nullptr;
+Rml::Context* rmlContext = nullptr;
+engine::input::Mouse::Setter* mouseSetter = nullptr;
+engine::input::Keyboard::Setter* keyboardSetter = nullptr;
+
+// This is defined by the "backend/linux/imgui.cpp" file, so we put an external reference here
+extern bool ImGuiX11EventHandler(const XEvent& event, KeySym keysym, const char* text);
+
+// Returns false when the key has no equivalent within the keyboard's keys.
+bool ToInputKey(KeySym keysym, engine::input::Keyboard::Key& key) {
+	if (keysym >= XK_a && keysym <= XK_z) {
+		key = (engine::input::Keyboard::Key)((int)engine::input::Keyboard::Key::A + (int)(keysym - XK_a));
+		return true;
+	} else if (keysym >= XK_F1 && keysym <= XK_F12) {
+		key = (engine::input::Keyboard::Key)((int)engine::input::Keyboard::Key::F1 + (int)(keysym - XK_F1));
+		return true;
+	}
+	switch (keysym) {
+		case XK_Tab:
+		case XK_ISO_Left_Tab:
+			key = engine::input::Keyboard::Key::Tab;
+			return true;
+		case XK_Left:
+			key = engine::input::Keyboard::Key::ArrowLeft;
+			return true;
+		case XK_Right:
+			key = engine::input::Keyboard::Key::ArrowRight;
+			return true;
+		case XK_Up:
+			key = engine::input::Keyboard::Key::ArrowUp;
+			return true;
+		case XK_Down:
+			key = engine::input::Keyboard::Key::ArrowDown;
+			return true;
+		case XK_Page_Up:
+			key = engine::input::Keyboard::Key::PageUp;
+			return true;
+		case XK_Page_Down:
+			key = engine::input::Keyboard::Key::PageDown;
+			return true;
+		case XK_Home:
+			key = engine::input::Keyboard::Key::Home;
+			return true;
+		case XK_End:
+			key = engine::input::Keyboard::Key::End;
+			return true;
+		case XK_Insert:
+			key = engine::input::Keyboard::Key::Insert;
+			return true;
+		case XK_Delete:
+			key = engine::input::Keyboard::Key::Delete;
+			return true;
+		case XK_BackSpace:
+			key = engine::input::Keyboard::Key::Backspace;
+			return true;
+		case XK_space:
+			key = engine::input::Keyboard::Key::Space;
+			return true;
+		case XK_Return:
+		case XK_KP_Enter:
+			key = engine::input::Keyboard::Key::Enter;
+			return true;
+		case XK_Escape:
+			key = engine::input::Keyboard::Key::Escape;
+			return true;
+		case XK_apostrophe:
+			key = engine::input::Keyboard::Key::Quote;
+			return true;
+		case XK_comma:
+			key = engine::input::Keyboard::Key::Comma;
+			return true;
+		case XK_minus:
+			key = engine::input::Keyboard::Key::Dash;
+			return true;
+		case XK_period:
+			key = engine::input::Keyboard::Key::Period;
+			return true;
+		case XK_slash:
+			key = engine::input::Keyboard::Key::ForwardSlash;
+			return true;
+		case XK_semicolon:
+			key = engine::input::Keyboard::Key::Semicolon;
+			return true;
+		case XK_equal:
+			key = engine::input::Keyboard::Key::Equals;
+			return true;
+		case XK_bracketleft:
+			key = engine::input::Keyboard::Key::LeftBrace;
+			return true;
+		case XK_backslash:
+			key = engine::input::Keyboard::Key::Backslash;
+			return true;
+		case XK_bracketright:
+			key = engine::input::Keyboard::Key::RightBrace;
+			return true;
+		case XK_grave:
+			key = engine::input::Keyboard::Key::Backtick;
+			return true;
+		case XK_Caps_Lock:
+			key = engine::input::Keyboard::Key::CapsLock;
+			return true;
+		case XK_Scroll_Lock:
+			key = engine::input::Keyboard::Key::ScrollLock;
+			return true;
+		case XK_Num_Lock:
+			key = engine::input::Keyboard::Key::NumLock;
+			return true;
+		case XK_Print:
+			key = engine::input::Keyboard::Key::PrintScreen;
+			return true;
+		case XK_Pause:
+			key = engine::input::Keyboard::Key::PauseBreak;
+			return true;
+		case XK_Shift_L:
+			key = engine::input::Keyboard::Key::LeftShift;
+			return true;
+		case XK_Control_L:
+			key = engine::input::Keyboard::Key::LeftCtrl;
+			return true;
+		case XK_Alt_L:
+			key = engine::input::Keyboard::Key::LeftAlt;
+			return true;
+		case XK_Shift_R:
+			key = engine::input::Keyboard::Key::RightShift;
+			return true;
+		case XK_Control_R:
+			key = engine::input::Keyboard::Key::RightCtrl;
+			return true;
+		case XK_Alt_R:
+		case XK_ISO_Level3_Shift: // AltGr
+			key = engine::input::Keyboard::Key::RightAlt;
+			return true;
+		case XK_0:
+			key = engine::input::Keyboard::Key::Number0;
+			return true;
+		case XK_1:
+			key = engine::input::Keyboard::Key::Number1;
+			return true;
+		case XK_2:
+			key = engine::input::Keyboard::Key::Number2;
+			return true;
+		case XK_3:
+			key = engine::input::Keyboard::Key::Number3;
+			return true;
+		case XK_4:
+			key = engine::input::Keyboard::Key::Number4;
+			return true;
+		case XK_5:
+			key = engine::input::Keyboard::Key::Number5;
+			return true;
+		case XK_6:
+			key = engine::input::Keyboard::Key::Number6;
+			return true;
+		case XK_7:
+			key = engine::input::Keyboard::Key::Number7;
+			return true;
+		case XK_8:
+			key = engine::input::Keyboard::Key::Number8;
+			return true;
+		case XK_9:
+			key = engine::input::Keyboard::Key::Number9;
+			return true;
+		default:
+			return false;
+	}
+}
+
+Rml::Input::KeyIdentifier ToRmlKey(KeySym keysym) {
+	if (keysym >= XK_a && keysym <= XK_z) {
+		return (Rml::Input::KeyIdentifier)(Rml::Input::KI_A + (keysym - XK_a));
+	} else if (keysym >= XK_0 && keysym <= XK_9) {
+		return (Rml::Input::KeyIdentifier)(Rml::Input::KI_0 + (keysym - XK_0));
+	} else if (keysym >= XK_F1 && keysym <= XK_F12) {
+		return (Rml::Input::KeyIdentifier)(Rml::Input::KI_F1 + (keysym - XK_F1));
+	}
+	switch (keysym) {
+		case XK_Tab:
+		case XK_ISO_Left_Tab:
+			return Rml::Input::KI_TAB;
+		case XK_Left:
+			return Rml::Input::KI_LEFT;
+		case XK_Right:
+			return Rml::Input::KI_RIGHT;
+		case XK_Up:
+			return Rml::Input::KI_UP;
+		case XK_Down:
+			return Rml::Input::KI_DOWN;
+		case XK_Page_Up:
+			return Rml::Input::KI_PRIOR;
+		case XK_Page_Down:
+			return Rml::Input::KI_NEXT;
+		case XK_Home:
+			return Rml::Input::KI_HOME;
+		case XK_End:
+			return Rml::Input::KI_END;
+		case XK_Insert:
+			return Rml::Input::KI_INSERT;
+		case XK_Delete:
+			return Rml::Input::KI_DELETE;
+		case XK_BackSpace:
+			return Rml::Input::KI_BACK;
+		case XK_space:
+			return Rml::Input::KI_SPACE;
+		case XK_Return:
+			return Rml::Input::KI_RETURN;
+		case XK_KP_Enter:
+			return Rml::Input::KI_NUMPADENTER;
+		case XK_Escape:
+			return Rml::Input::KI_ESCAPE;
+		case XK_apostrophe:
+			return Rml::Input::KI_OEM_7;
+		case XK_comma:
+			return Rml::Input::KI_OEM_COMMA;
+		case XK_minus:
+			return Rml::Input::KI_OEM_MINUS;
+		case XK_period:
+			return Rml::Input::KI_OEM_PERIOD;
+		case XK_slash:
+			return Rml::Input::KI_OEM_2;
+		case XK_semicolon:
+			return Rml::Input::KI_OEM_1;
+		case XK_equal:
+			return Rml::Input::KI_OEM_PLUS;
+		case XK_bracketleft:
+			return Rml::Input::KI_OEM_4;
+		case XK_backslash:
+			return Rml::Input::KI_OEM_5;
+		case XK_bracketright:
+			return Rml::Input::KI_OEM_6;
+		case XK_grave:
+			return Rml::Input::KI_OEM_3;
+		case XK_Caps_Lock:
+			return Rml::Input::KI_CAPITAL;
+		case XK_Scroll_Lock:
+			return Rml::Input::KI_SCROLL;
+		case XK_Num_Lock:
+			return Rml::Input::KI_NUMLOCK;
+		case XK_Print:
+			return Rml::Input::KI_SNAPSHOT;
+		case XK_Pause:
+			return Rml::Input::KI_PAUSE;
+		case XK_Shift_L:
+			return Rml::Input::KI_LSHIFT;
+		case XK_Control_L:
+			return Rml::Input::KI_LCONTROL;
+		case XK_Alt_L:
+			return Rml::Input::KI_LMENU;
+		case XK_Shift_R:
+			return Rml::Input::KI_RSHIFT;
+		case XK_Control_R:
+			return Rml::Input::KI_RCONTROL;
+		case XK_Alt_R:
+			return Rml::Input::KI_RMENU;
+		default:
+			return Rml::Input::KI_UNKNOWN;
+	}
+}
+
+// X reports the held modifiers with every key and button event, so the modifiers are read from the event's state
+// rather than tracked across events.
+int ToRmlModifiers(unsigned int state) {
+	int modifiers = 0;
+	if (state & ShiftMask) {
+		modifiers |= Rml::Input::KeyModifier::KM_SHIFT;
+	}
+	if (state & ControlMask) {
+		modifiers |= Rml::Input::KeyModifier::KM_CTRL;
+	}
+	if (state & Mod1Mask) {
+		modifiers |= Rml::Input::KeyModifier::KM_ALT;
+	}
+	if (state & LockMask) {
+		modifiers |= Rml::Input::KeyModifier::KM_CAPSLOCK;
+	}
+	if (state & Mod2Mask) {
+		modifiers |= Rml::Input::KeyModifier::KM_NUMLOCK;
+	}
+	return modifiers;
+}
+
+engine::Application::PlatformImplementation::PlatformCallbacks::PlatformCallbacks(engine::Application::CommonImplementation* commonImpl) {
+	::commonImpl = commonImpl;
+	::callbackImpl = this;
+}
+
+engine::Application::PlatformImplementation::PlatformCallbacks::~PlatformCallbacks() = default;
+
+void engine::Application::PlatformImplementation::PlatformCallbacks::MessageProc(XEvent& event) {
+	auto data = ::commonImpl->application->platImpl->Data.get();
+	// Text must be looked up before ImGui and RmlUi see the key, as the input context may only look up each key once
+	KeySym keysym = NoSymbol;
+	char text[32] = {};
+	bool hasText = false;
+	if (event.type == KeyPress || event.type == KeyRelease) {
+		keysym = XLookupKeysym(&event.xkey, 0);
+		if (event.type == KeyPress) {
+			int length;
+			if (data->InputContext) {
+				length = Xutf8LookupString(data->InputContext, &event.xkey, text, sizeof(text) - 1, nullptr, nullptr);
+			} else {
+				length = XLookupString(&event.xkey, text, sizeof(text) - 1, nullptr, nullptr);
+			}
+			if (length > 0 && length < (int)sizeof(text)) {
+				text[length] = '\0';
+				hasText = true;
+			}
+		}
+	}
+	if (ImGuiX11EventHandler(event, keysym, hasText ? text : nullptr)) {
+		return;
+	}
+
+	switch (event.type) {
+		case ConfigureNotify: // Window size may have been changed
+			if ((std::uint32_t)event.xconfigure.width != data->Width || (std::uint32_t)event.xconfigure.height != data->Height) {
+				data->Width = (std::uint32_t)event.xconfigure.width;
+				data->Height = (std::uint32_t)event.xconfigure.height;
+				::commonImpl->HandleResize(data->Width, data->Height);
+			}
+			return;
+
+		case ClientMessage:
+			if ((Atom)event.xclient.data.l[0] == data->DeleteWindowAtom) {
+				data->QuitRequested = true;
+			}
+			return;
+
+		case MotionNotify: {
+			int mouseX = event.xmotion.x;
+			int mouseY = event.xmotion.y;
+			// Warping the pointer back to the center in hard capture generates its own motion, which is not a delta
+			bool isHardCapture = ::commonImpl->application->inputHandler->GetMouseCaptureState() == engine::input::Mouse::CaptureState::Hard;
+			if (isHardCapture && mouseX == int(data->Width / 2) && mouseY == int(data->Height / 2)) {
+				return;
+			}
+			data->ReceivedMouseMove = true;
+			if (::rmlContext && ::rmlContext->ProcessMouseMove(mouseX, mouseY, ToRmlModifiers(event.xmotion.state))) {
+				::mouseSetter->SetPosition((float)mouseX, (float)mouseY);
+				if (isHardCapture) {
+					auto dX = float(mouseX - int(data->Width / 2));
+					auto dY = float(mouseY - int(data->Height / 2));
+					::mouseSetter->SetDelta(dX, dY);
+				}
+			}
+			return;
+		}
+		case LeaveNotify:
+			// Grabbing the pointer also sends a leave, although the pointer has not left the window
+			if (::rmlContext && event.xcrossing.mode == NotifyNormal) {
+				::rmlContext->ProcessMouseLeave();
+			}
+			return;
+		case ButtonPress:
+		case ButtonRelease: {
+			bool isDown = event.type == ButtonPress;
+			int rmlModifiers = ToRmlModifiers(event.xbutton.state);
+			// Buttons 4 through 7 are the vertical and horizontal scroll wheels, which only report presses
+			if (event.xbutton.button >= Button4 && event.xbutton.button <= 7) {
+				if (!isDown || event.xbutton.button > Button5) {
+					return;
+				}
+				float wheelDelta = (event.xbutton.button == Button4) ? -1.0f : 1.0f;
+				if (::rmlContext && !::rmlContext->ProcessMouseWheel(wheelDelta, rmlModifiers)) {
+					return;
+				}
+				::mouseSetter->SetScrollWheel(wheelDelta);
+				return;
+			}
+			int rmlButton;
+			engine::input::Mouse::Button button;
+			switch (event.xbutton.button) {
+				case Button1:
+					rmlButton = 0;
+					button = engine::input::Mouse::Button::Left;
+					break;
+				case Button2:
+					rmlButton = 2;
+					button = engine::input::Mouse::Button::Middle;
+					break;
+				case Button3:
+					rmlButton = 1;
+					button = engine::input::Mouse::Button::Right;
+					break;
+				default:
+					return;
+			}
+			if (isDown && ::rmlContext && !::rmlContext->ProcessMouseButtonDown(rmlButton, rmlModifiers)) {
+				return;
+			} else if (!isDown && ::rmlContext && !::rmlContext->ProcessMouseButtonUp(rmlButton, rmlModifiers)) {
+				return;
+			}
+			::mouseSetter->SetButton(button, isDown, ::commonImpl->guiBackend->GetElapsedTime());
+			return;
+		}
+		case KeyPress:
+		case KeyRelease: {
+			bool isDown = event.type == KeyPress;
+			int rmlModifiers = ToRmlModifiers(event.xkey.state);
+			if (::rmlContext) {
+				if (isDown && !::rmlContext->ProcessKeyDown(ToRmlKey(keysym), rmlModifiers)) {
+					return;
+				} else if (!isDown && !::rmlContext->ProcessKeyUp(ToRmlKey(keysym), rmlModifiers)) {
+					return;
+				}
+				// Control characters such as backspace and escape are handled as keys, rather than as text
+				if (hasText && (rmlModifiers & (Rml::Input::KeyModifier::KM_CTRL | Rml::Input::KeyModifier::KM_ALT)) == 0 &&
+					text[0] != 0x08 /*Backspace*/ && text[0] != 0x1b /*Escape*/ && text[0] != 0x7f /*Delete*/ &&
+					!::rmlContext->ProcessTextInput(Rml::String(text))) {
+					return;
+				}
+			}
+			engine::input::Keyboard::Key key;
+			if (ToInputKey(keysym, key)) {
+				::keyboardSetter->SetKey(key, isDown, ::commonImpl->guiBackend->GetElapsedTime());
+			}
+			return;
+		}
+		case FocusIn:
+			if (event.xfocus.mode == NotifyGrab || event.xfocus.mode == NotifyUngrab) {
+				return;
+			}
+			if (data->InputContext) {
+				XSetICFocus(data->InputContext);
+			}
+			::commonImpl->application->inputHandler->SetMouseCaptureState(data->LastState);
+			return;
+		case FocusOut:
+			if (event.xfocus.mode == NotifyGrab || event.xfocus.mode == NotifyUngrab) {
+				return;
+			}
+			if (data->InputContext) {
+				XUnsetICFocus(data->InputContext);
+			}
+			data->LastState = ::commonImpl->application->inputHandler->GetMouseCaptureState();
+			::commonImpl->application->inputHandler->SetMouseCaptureState(engine::input::Mouse::CaptureState::None);
+			return;
+		default:
+			return;
+	}
+}
+
+bool engine::Application::PlatformImplementation::ProcessMessages() {
+	if (::rmlContext == nullptr) {
+		::rmlContext = ::commonImpl->application->rmlContext;
+		::mouseSetter = Data->MouseSetter.get();
+		::keyboardSetter = Data->KeyboardSetter.get();
+	}
+	XEvent event;
+	while (XPending(Data->XDisplay) > 0) {
+		XNextEvent(Data->XDisplay, &event);
+		// Input methods may consume events as part of composing text
+		if (XFilterEvent(&event, 0)) {
+			continue;
+		}
+		Callbacks->MessageProc(event);
+		if (Data->QuitRequested) {
+			return false;
+		}
+	}
+	return !Data->QuitRequested;
+}
+
+#endif //PLATFORM_LINUX && !ENGINE_HEADLESS
@@ -0,0 +1,114 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#if defined(PLATFORM_LINUX) && !defined(ENGINE_HEADLESS)
+
+#include <engine/backend/linux.hpp>
+#include <X11/cursorfont.h>
+#include <time.h>
+
+class engine::gui::Backend::PlatformImplementation {
+public:
+	Display* display = nullptr;
+	Window window = 0;
+	timespec startup = {};
+	// Text copied from this application. Pasting from other applications requires a selection request round trip,
+	// which RmlUi's synchronous interface cannot wait on, so only text copied from within the application is pasted.
+	Rml::String clipboard;
+	Cursor cursorDefault = 0;
+	Cursor cursorMove = 0;
+	Cursor cursorPointer = 0;
+	Cursor cursorResize = 0;
+	Cursor cursorCross = 0;
+	Cursor cursorText = 0;
+	Cursor cursorUnavailable = 0;
+};
+
+engine::gui::Backend::Backend() = default;
+
+engine::gui::Backend::~Backend() {
+	if (platImpl && platImpl->display) {
+		for (Cursor cursor: {platImpl->cursorDefault, platImpl->cursorMove, platImpl->cursorPointer, platImpl->cursorResize,
+							 platImpl->cursorCross, platImpl->cursorText, platImpl->cursorUnavailable}) {
+			XFreeCursor(platImpl->display, cursor);
+		}
+	}
+}
+
+void engine::gui::Backend::Initialize(void* data) {
+	auto platformData = reinterpret_cast<engine::Application::PlatformImplementation::PlatformData*>(data);
+	platImpl = std::make_unique<engine::gui::Backend::PlatformImplementation>();
+	platImpl->display = platformData->XDisplay;
+	platImpl->window = platformData->WindowHandle;
+
+	clock_gettime(CLOCK_MONOTONIC, &platImpl->startup);
+
+	// Load cursors
+	platImpl->cursorDefault = XCreateFontCursor(platImpl->display, XC_left_ptr);
+	platImpl->cursorMove = XCreateFontCursor(platImpl->display, XC_fleur);
+	platImpl->cursorPointer = XCreateFontCursor(platImpl->display, XC_hand2);
+	platImpl->cursorResize = XCreateFontCursor(platImpl->display, XC_bottom_right_corner);
+	platImpl->cursorCross = XCreateFontCursor(platImpl->display, XC_crosshair);
+	platImpl->cursorText = XCreateFontCursor(platImpl->display, XC_xterm);
+	platImpl->cursorUnavailable = XCreateFontCursor(platImpl->display, XC_X_cursor);
+}
+
+double engine::gui::Backend::GetElapsedTime() {
+	timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return double(now.tv_sec - platImpl->startup.tv_sec) + double(now.tv_nsec - platImpl->startup.tv_nsec) * 1e-9;
+}
+
+void engine::gui::Backend::SetMouseCursor(const Rml::String& cursorName) {
+	if (platImpl->window) {
+		Cursor cursorHandle = 0;
+		if (cursorName.empty() || cursorName == "arrow") {
+			cursorHandle = platImpl->cursorDefault;
+		} else if (cursorName == "move") {
+			cursorHandle = platImpl->cursorMove;
+		} else if (cursorName == "pointer") {
+			cursorHandle = platImpl->cursorPointer;
+		} else if (cursorName == "resize") {
+			cursorHandle = platImpl->cursorResize;
+		} else if (cursorName == "cross") {
+			cursorHandle = platImpl->cursorCross;
+		} else if (cursorName == "text") {
+			cursorHandle = platImpl->cursorText;
+		} else if (cursorName == "unavailable") {
+			cursorHandle = platImpl->cursorUnavailable;
+		}
+
+		if (cursorHandle) {
+			XDefineCursor(platImpl->display, platImpl->window, cursorHandle);
+		}
+	}
+}
+
+void engine::gui::Backend::SetClipboardText(const Rml::String& textUtf8) {
+	if (platImpl->window) {
+		platImpl->clipboard = textUtf8;
+		// Take ownership so that other applications no longer paste their own stale selection
+		XSetSelectionOwner(platImpl->display, XInternAtom(platImpl->display, "CLIPBOARD", 0), platImpl->window, CurrentTime);
+	}
+}
+
+void engine::gui::Backend::GetClipboardText(Rml::String& text) {
+	if (platImpl->window) {
+		text = platImpl->clipboard;
+	}
+}
+
+void engine::gui::Backend::ActivateKeyboard(Rml::Vector2f caretPosition, float lineHeight) {}
+
+bool engine::Application::PlatformImplementation::SetGUIBackend() {
+	application->commonImpl->guiBackend->Initialize(Data.get());
+	application->commonImpl->guiRenderer->Initialize(application);
+	Rml::SetSystemInterface(application->commonImpl->guiBackend.get());
+	Rml::SetRenderInterface(application->commonImpl->guiRenderer.get());
+	return true;
+}
+
+#endif //PLATFORM_LINUX && !ENGINE_HEADLESS
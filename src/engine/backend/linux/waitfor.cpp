@@ -0,0 +1,43 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#if defined(PLATFORM_LINUX) && !defined(ENGINE_HEADLESS)
+
+#include <engine/backend/linux.hpp>
+#include <cerrno>
+#include <time.h>
+
+static std::int64_t toNanoseconds(const timespec& time) {
+	return (std::int64_t)time.tv_sec * 1'000'000'000 + time.tv_nsec;
+}
+
+// Follows the same approach as the Windows high resolution timer: sleep against an absolute deadline until just before
+// the target, then spin the remainder, as the scheduler may wake the thread up to a timer slack late.
+void engine::Application::PlatformImplementation::WaitFor(double seconds) {
+	timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	std::int64_t target = toNanoseconds(now) + (std::int64_t)(seconds * 1'000'000'000.0);
+
+	const std::int64_t TOLERANCE = 1'020'000;
+	std::int64_t sleepUntil = target - TOLERANCE;
+	if (sleepUntil > toNanoseconds(now)) {
+		timespec due = {.tv_sec = (time_t)(sleepUntil / 1'000'000'000), .tv_nsec = (long)(sleepUntil % 1'000'000'000)};
+		// An absolute deadline is unaffected by signals that interrupt the sleep, so the sleep is simply resumed
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &due, nullptr) == EINTR) {}
+		clock_gettime(CLOCK_MONOTONIC, &now);
+	}
+
+	while (toNanoseconds(now) < target) {
+#if defined(__x86_64__) || defined(__i386__)
+		__builtin_ia32_pause();
+#elif defined(__aarch64__)
+		asm volatile("yield");
+#endif
+		clock_gettime(CLOCK_MONOTONIC, &now);
+	}
+}
+
+#endif //PLATFORM_LINUX && !ENGINE_HEADLESS
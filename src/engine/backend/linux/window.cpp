@@ -0,0 +1,85 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#if defined(PLATFORM_LINUX) && !defined(ENGINE_HEADLESS)
+
+#include <engine/backend/linux.hpp>
+#include <engine/log/log.hpp>
+
+bool engine::Application::PlatformImplementation::InitializeWindow() {
+	auto appOptions = application->StartOptions();
+	// Wayland sessions are served through XWayland, as the renderer's swap chain takes an X11 window
+	Data->XDisplay = XOpenDisplay(nullptr);
+	if (!Data->XDisplay) {
+		engine::log::Error("Cannot open the X display");
+		return false;
+	}
+	Display* display = Data->XDisplay;
+	int screen = DefaultScreen(display);
+	Window root = RootWindow(display, screen);
+
+	// Create a window
+	XSetWindowAttributes attributes = {};
+	attributes.background_pixel = BlackPixel(display, screen);
+	attributes.event_mask = ExposureMask | StructureNotifyMask | FocusChangeMask | KeyPressMask | KeyReleaseMask |
+							ButtonPressMask | ButtonReleaseMask | PointerMotionMask | LeaveWindowMask;
+	Data->WindowHandle = XCreateWindow(display, root, 0, 0, appOptions.Width, appOptions.Height, 0, CopyFromParent,
+									   InputOutput, CopyFromParent, CWBackPixel | CWEventMask, &attributes);
+	if (!Data->WindowHandle) {
+		engine::log::Error("Cannot create window");
+		return false;
+	}
+	Data->Width = appOptions.Width;
+	Data->Height = appOptions.Height;
+
+	// Set the title for both older window managers and those that expect UTF-8
+	XStoreName(display, Data->WindowHandle, appOptions.Title.c_str());
+	Atom netWmName = XInternAtom(display, "_NET_WM_NAME", 0);
+	Atom utf8String = XInternAtom(display, "UTF8_STRING", 0);
+	XChangeProperty(display, Data->WindowHandle, netWmName, utf8String, 8, PropModeReplace,
+					(const unsigned char*)appOptions.Title.c_str(), (int)appOptions.Title.size());
+
+	// Closing the window is sent as a message rather than destroying the window out from under the renderer
+	Data->DeleteWindowAtom = XInternAtom(display, "WM_DELETE_WINDOW", 0);
+	XSetWMProtocols(display, Data->WindowHandle, &Data->DeleteWindowAtom, 1);
+
+	XSizeHints* sizeHints = XAllocSizeHints();
+	sizeHints->flags = PMinSize;
+	sizeHints->min_width = (int)engine::graphics::MinimumWindowWidth;
+	sizeHints->min_height = (int)engine::graphics::MinimumWindowHeight;
+	XSetWMNormalHints(display, Data->WindowHandle, sizeHints);
+	XFree(sizeHints);
+
+	// Held keys would otherwise repeat as release and press pairs, rather than as presses alone
+	XkbSetDetectableAutoRepeat(display, 1, nullptr);
+
+	// An input context is needed to receive composed and non-latin text
+	Data->InputMethod = XOpenIM(display, nullptr, nullptr, nullptr);
+	if (Data->InputMethod) {
+		Data->InputContext = XCreateIC(Data->InputMethod, XNInputStyle, XIMPreeditNothing | XIMStatusNothing,
+									   XNClientWindow, Data->WindowHandle, XNFocusWindow, Data->WindowHandle, nullptr);
+	}
+	if (!Data->InputContext) {
+		engine::log::Debug("No X input method is available, so text input is limited to Latin-1");
+	}
+
+	// Hard capture hides the cursor by replacing it with an empty one
+	char emptyData[8] = {};
+	Pixmap emptyPixmap = XCreateBitmapFromData(display, Data->WindowHandle, emptyData, 8, 8);
+	XColor black = {};
+	Data->HiddenCursor = XCreatePixmapCursor(display, emptyPixmap, emptyPixmap, &black, &black, 0, 0);
+	XFreePixmap(display, emptyPixmap);
+
+	XMapWindow(display, Data->WindowHandle);
+	XFlush(display);
+	return true;
+}
+
+void* engine::Application::PlatformImplementation::GetWindowHandle() const {
+	return (void*)(std::uintptr_t)Data->WindowHandle;
+}
+
+#endif //PLATFORM_LINUX && !ENGINE_HEADLESS
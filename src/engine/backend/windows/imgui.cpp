@@ -4,7 +4,7 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
-#ifdef PLATFORM_WIN32
+#if defined(PLATFORM_WIN32) && !defined(ENGINE_HEADLESS)
 
 #include <engine/backend/windows.hpp>
 
@@ -25,4 +25,4 @@ void engine::Application::PlatformImplementation::ImGuiShutdown() {
 	ImGui_ImplWin32_Shutdown();
 }
 
-#endif //PLATFORM_WIN32
+#endif //PLATFORM_WIN32 && !ENGINE_HEADLESS
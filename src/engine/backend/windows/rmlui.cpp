@@ -4,7 +4,7 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
-#ifdef PLATFORM_WIN32
+#if defined(PLATFORM_WIN32) && !defined(ENGINE_HEADLESS)
 
 #include <engine/backend/windows.hpp>
 #include <engine/strings/strings.hpp>
@@ -128,4 +128,4 @@ bool engine::Application::PlatformImplementation::SetGUIBackend() {
 	return true;
 }
 
-#endif //PLATFORM_WIN32
+#endif //PLATFORM_WIN32 && !ENGINE_HEADLESS
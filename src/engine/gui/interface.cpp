@@ -8,6 +8,18 @@
 #include <engine/gui/renderer.hpp>
 #include <stb_image.h>
 
+static_assert(sizeof(Rml::CompiledGeometryHandle) >= sizeof(std::uint64_t), "RmlUi geometry handles must be able to hold a slot handle");
+
+// RmlUi treats a zero handle as a failure, so the index is offset by one
+Rml::CompiledGeometryHandle toRmlGeometryHandle(engine::utils::SlotHandle handle) {
+	return (Rml::CompiledGeometryHandle)(((std::uint64_t)handle.Generation << 32) | ((std::uint64_t)handle.Index + 1));
+}
+
+engine::utils::SlotHandle fromRmlGeometryHandle(Rml::CompiledGeometryHandle geometryHandle) {
+	auto packed = (std::uint64_t)geometryHandle;
+	return engine::utils::SlotHandle{.Index = (std::uint32_t)(packed & 0xFFFFFFFF) - 1, .Generation = (std::uint32_t)(packed >> 32)};
+}
+
 void engine::gui::Renderer::Initialize(engine::Application* app) {
 	application = app;
 	filament::Engine& engine = *engine::graphics::GetEngine();
@@ -54,7 +66,7 @@ Rml::CompiledGeometryHandle engine::gui::Renderer::CompileGeometry(Rml::Vertex*
 	} else {
 		materialInstance->setParameter("albedo", emptyTexture, sampler);
 	}
-	auto compiledGeometry = new RmlCompiledGeometry{
+	auto handle = compiledGeometry.Insert(RmlCompiledGeometry{
 		.Transform = currentTransform,
 		.Translation = {0, 0},
 		.Texture = texture,
@@ -62,27 +74,31 @@ Rml::CompiledGeometryHandle engine::gui::Renderer::CompileGeometry(Rml::Vertex*
 		.MaterialInstance = materialInstance,
 		.Vertexes = vertexSection,
 		.Indexes = indexSection,
-	};
-	return reinterpret_cast<Rml::CompiledGeometryHandle>(compiledGeometry);
+	});
+	return toRmlGeometryHandle(handle);
 }
 
 void engine::gui::Renderer::RenderCompiledGeometry(Rml::CompiledGeometryHandle geometryHandle, const Rml::Vector2f& translation) {
-	auto compiledGeometry = reinterpret_cast<RmlCompiledGeometry*>(geometryHandle);
+	auto geometry = compiledGeometry.Get(fromRmlGeometryHandle(geometryHandle));
+	if (!geometry) {
+		engine::log::Error("Attempted to render released GUI geometry");
+		return;
+	}
 	auto compFunc = (currentState == RenderState::CompareStencil) ? filament::MaterialInstance::StencilCompareFunc::E : filament::MaterialInstance::StencilCompareFunc::A;
-	compiledGeometry->MaterialInstance->setStencilCompareFunction(compFunc, filament::MaterialInstance::StencilFace::FRONT_AND_BACK);
+	geometry->MaterialInstance->setStencilCompareFunction(compFunc, filament::MaterialInstance::StencilFace::FRONT_AND_BACK);
 	frameGeometry.push_back(engine::gui::RmlCompiledGeometry{
 		.Transform = currentTransform,
 		.Translation = {translation.x, translation.y},
-		.Texture = compiledGeometry->Texture,
+		.Texture = geometry->Texture,
 		.State = currentState,
-		.MaterialInstance = compiledGeometry->MaterialInstance,
-		.Vertexes = compiledGeometry->Vertexes,
-		.Indexes = compiledGeometry->Indexes,
+		.MaterialInstance = geometry->MaterialInstance,
+		.Vertexes = geometry->Vertexes,
+		.Indexes = geometry->Indexes,
 	});
 }
 
 void engine::gui::Renderer::ReleaseCompiledGeometry(Rml::CompiledGeometryHandle geometryHandle) {
-	geometryToDelete.push_back(reinterpret_cast<RmlCompiledGeometry*>(geometryHandle));
+	geometryToDelete.push_back(fromRmlGeometryHandle(geometryHandle));
 }
 
 void engine::gui::Renderer::RenderGeometry(Rml::Vertex* vertexes, int vertexCount, int* indexes, int indexCount, Rml::TextureHandle textureHandle, const Rml::Vector2f& translation) {
@@ -185,13 +185,17 @@ void engine::gui::Renderer::makeStencilMaterials(int newCount) {
 
 void engine::gui::Renderer::deletePending() {
 	auto engine = engine::graphics::GetEngine();
-	for (auto compiledGeometry: geometryToDelete) {
-		vertexFreeList.Deallocate(compiledGeometry->Vertexes);
-		indexFreeList.Deallocate(compiledGeometry->Indexes);
-		if (compiledGeometry->State != RenderState::ClearStencil && compiledGeometry->State != RenderState::SetStencil) {
-			engine->destroy(compiledGeometry->MaterialInstance);
+	for (auto handle: geometryToDelete) {
+		auto geometry = compiledGeometry.Get(handle);
+		if (!geometry) {
+			continue;
 		}
-		delete (compiledGeometry);
+		vertexFreeList.Deallocate(geometry->Vertexes);
+		indexFreeList.Deallocate(geometry->Indexes);
+		if (geometry->State != RenderState::ClearStencil && geometry->State != RenderState::SetStencil) {
+			engine->destroy(geometry->MaterialInstance);
+		}
+		compiledGeometry.Erase(handle);
 	}
 	geometryToDelete.clear();
 	for (auto texture: texturesToDelete) {
@@ -10,18 +10,22 @@
 const std::uint32_t mouseFlag = 0b001 << 28;
 const std::uint32_t keyboardFlag = 0b010 << 28;
 const std::uint32_t gamepadFlag = 0b100 << 28;
+const std::uint32_t generationShift = 16;
+const std::uint32_t generationMask = 0xFFF;
+const std::uint32_t indexMask = 0xFFFF;
 
-engine::input::Device::Device(engine::input::Handler* handler, engine::input::Device::Type type, std::uint16_t id) {
+engine::input::Device::Device(engine::input::Handler* handler, engine::input::Device::Type type, engine::utils::SlotHandle handle) {
 	this->handler = handler;
+	std::uint32_t packedHandle = ((handle.Generation & generationMask) << generationShift) | (handle.Index & indexMask);
 	switch (type) {
 		case engine::input::Device::Type::Mouse:
-			this->id.Raw = mouseFlag + id;
+			this->id.Raw = mouseFlag | packedHandle;
 			break;
 		case engine::input::Device::Type::Keyboard:
-			this->id.Raw = keyboardFlag + id;
+			this->id.Raw = keyboardFlag | packedHandle;
 			break;
 		case engine::input::Device::Type::Gamepad:
-			this->id.Raw = gamepadFlag + id;
+			this->id.Raw = gamepadFlag | packedHandle;
 			break;
 		default:
 			engine::log::Fatal("Unknown Device type encountered");
@@ -65,3 +69,7 @@ engine::input::Device::Type engine::input::Device::ID::GetType() const {
 			return Type::Mouse;
 	}
 }
+
+engine::utils::SlotHandle engine::input::Device::ID::GetHandle() const {
+	return engine::utils::SlotHandle{.Index = Raw & indexMask, .Generation = (Raw >> generationShift) & generationMask};
+}
@@ -74,7 +74,7 @@ void engine::input::Gamepad::Setter::SetStick(Stick stick, float x, float y) {
 
 // Gamepad -------------------------------------------------------------------------------------------------------------
 
-engine::input::Gamepad::Gamepad(Handler* handler, std::uint16_t id) : Device(handler, Device::Type::Gamepad, id) {
+engine::input::Gamepad::Gamepad(Handler* handler, engine::utils::SlotHandle handle) : Device(handler, Device::Type::Gamepad, handle) {
 	buttons.resize(18);
 	triggers.resize(2);
 	sticks.resize(2);
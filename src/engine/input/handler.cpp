@@ -9,72 +9,55 @@
 
 engine::input::Handler::Handler(engine::Application* application) : application(application) {}
 
+template<typename T>
+std::shared_ptr<T> engine::input::Handler::getDevice(Device::ID id, Device::Type type) {
+	// The handle only covers the index and generation, so the type is checked against the full ID
+	auto device = devices.Get(id.GetHandle());
+	if (!device || (*device)->id.Raw != id.Raw || (*device)->GetType() != type) {
+		engine::log::Error("Device with ID '%u' not found", id.Raw);
+		return nullptr;
+	}
+	return std::static_pointer_cast<T>(*device);
+}
+
+template<typename T>
+std::unique_ptr<typename T::Setter> engine::input::Handler::connectDevice() {
+	// The device's ID contains its handle, so the slot is reserved before the device is created
+	auto handle = devices.Insert(nullptr);
+	auto device = std::shared_ptr<T>(new T(this, handle));
+	*devices.Get(handle) = device;
+	return std::unique_ptr<typename T::Setter>(new typename T::Setter(std::move(device)));
+}
+
 engine::input::Handler::~Handler() {
-	for (int i = (int)devices.size() - 1; i >= 0; i--) {
-		auto device = devices[i];
-		device->isConnected = false;
-		devices.erase(devices.begin() + i);
-		for (const auto& callback: device->onDisconnect) {
-			callback(device->id);
-		}
+	// Disconnecting from the back means that no other devices are moved
+	while (devices.Size() > 0) {
+		DisconnectDevice((*(devices.end() - 1))->id);
 	}
 }
 
 std::shared_ptr<engine::input::Mouse> engine::input::Handler::GetDevice(MouseID id) {
-	for (auto& device: devices) {
-		if (device->id.Raw == id.ID.Raw) {
-			return std::static_pointer_cast<engine::input::Mouse>(device);
-		}
-	}
-	engine::log::Error("Device with ID '%u' not found", id.ID.Raw);
-	return nullptr;
+	return getDevice<engine::input::Mouse>(id.ID, engine::input::Device::Type::Mouse);
 }
 
 std::shared_ptr<engine::input::Keyboard> engine::input::Handler::GetDevice(KeyboardID id) {
-	for (auto& device: devices) {
-		if (device->id.Raw == id.ID.Raw) {
-			return std::static_pointer_cast<engine::input::Keyboard>(device);
-		}
-	}
-	engine::log::Error("Device with ID '%u' not found", id.ID.Raw);
-	return nullptr;
+	return getDevice<engine::input::Keyboard>(id.ID, engine::input::Device::Type::Keyboard);
 }
 
 std::shared_ptr<engine::input::Gamepad> engine::input::Handler::GetDevice(GamepadID id) {
-	for (auto& device: devices) {
-		if (device->id.Raw == id.ID.Raw) {
-			return std::static_pointer_cast<engine::input::Gamepad>(device);
-		}
-	}
-	engine::log::Error("Device with ID '%u' not found", id.ID.Raw);
-	return nullptr;
+	return getDevice<engine::input::Gamepad>(id.ID, engine::input::Device::Type::Gamepad);
 }
 
 std::unique_ptr<engine::input::Mouse::Setter> engine::input::Handler::ConnectMouse() {
-	auto device = std::shared_ptr<engine::input::Device>(new engine::input::Mouse(this, nextId));
-	nextId += 1;
-	auto setter = std::unique_ptr<engine::input::Mouse::Setter>(
-		new engine::input::Mouse::Setter(std::static_pointer_cast<Mouse>(device)));
-	devices.push_back(std::move(device));
-	return std::move(setter);
+	return connectDevice<engine::input::Mouse>();
 }
 
 std::unique_ptr<engine::input::Keyboard::Setter> engine::input::Handler::ConnectKeyboard() {
-	auto device = std::shared_ptr<engine::input::Device>(new engine::input::Keyboard(this, nextId));
-	nextId += 1;
-	auto setter = std::unique_ptr<engine::input::Keyboard::Setter>(
-		new engine::input::Keyboard::Setter(std::static_pointer_cast<Keyboard>(device)));
-	devices.push_back(std::move(device));
-	return std::move(setter);
+	return connectDevice<engine::input::Keyboard>();
 }
 
 std::unique_ptr<engine::input::Gamepad::Setter> engine::input::Handler::ConnectGamepad() {
-	auto device = std::shared_ptr<engine::input::Device>(new engine::input::Gamepad(this, nextId));
-	nextId += 1;
-	auto setter = std::unique_ptr<engine::input::Gamepad::Setter>(
-		new engine::input::Gamepad::Setter(std::static_pointer_cast<Gamepad>(device)));
-	devices.push_back(std::move(device));
-	return std::move(setter);
+	return connectDevice<engine::input::Gamepad>();
 }
 
 std::vector<engine::input::Handler::MouseID> engine::input::Handler::ListConnectedMice() {
@@ -112,16 +95,15 @@ engine::input::Mouse::CaptureState engine::input::Handler::GetMouseCaptureState(
 }
 
 void engine::input::Handler::DisconnectDevice(Device::ID id) {
-	for (int i = 0; i < devices.size(); i++) {
-		if (devices[i]->id.Raw == id.Raw) {
-			auto device = devices[i];
-			device->isConnected = false;
-			devices.erase(devices.begin() + i);
-			for (const auto& callback: device->onDisconnect) {
-				callback(id);
-			}
-			return;
-		}
+	auto devicePtr = devices.Get(id.GetHandle());
+	if (!devicePtr || (*devicePtr)->id.Raw != id.Raw) {
+		return;
+	}
+	auto device = *devicePtr;
+	device->isConnected = false;
+	devices.Erase(id.GetHandle());
+	for (const auto& callback: device->onDisconnect) {
+		callback(id);
 	}
 }
 
@@ -148,7 +148,7 @@ void engine::input::Keyboard::Setter::SetKey(Key key, bool isDown, double curren
 
 // Keyboard ------------------------------------------------------------------------------------------------------------
 
-engine::input::Keyboard::Keyboard(Handler* handler, std::uint16_t id) : Device(handler, Device::Type::Keyboard, id) {
+engine::input::Keyboard::Keyboard(Handler* handler, engine::utils::SlotHandle handle) : Device(handler, Device::Type::Keyboard, handle) {
 	keys.resize(128);
 	std::fill(keys.begin(), keys.end(), Keyboard::keyState{});
 }
@@ -59,7 +59,7 @@ void engine::input::Mouse::Setter::SetScrollWheel(float value) {
 
 // Mouse ---------------------------------------------------------------------------------------------------------------
 
-engine::input::Mouse::Mouse(Handler* handler, std::uint16_t id) : Device(handler, Device::Type::Mouse, id) {
+engine::input::Mouse::Mouse(Handler* handler, engine::utils::SlotHandle handle) : Device(handler, Device::Type::Mouse, handle) {
 	buttons.resize(3);
 	std::fill(buttons.begin(), buttons.end(), Mouse::buttonState{});
 }
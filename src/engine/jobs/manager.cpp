@@ -0,0 +1,227 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <engine/jobs/manager.hpp>
+#include <algorithm>
+
+namespace engine::jobs {
+	Manager* GlobalManager = nullptr;
+}
+
+// The index of the worker that owns the current thread, which lets jobs that are submitted from a worker be queued on
+// that worker.
+static thread_local std::uint32_t currentWorker = 0xFFFFFFFF;
+
+engine::jobs::Manager::Manager(std::uint32_t workerCount) {
+	if (workerCount == 0) {
+		workerCount = std::max((int)std::thread::hardware_concurrency() - 1, 1);
+	}
+	for (std::uint32_t i = 0; i <= workerCount; i++) {
+		queues.push_back(std::make_unique<workQueue>());
+	}
+	workers.reserve(workerCount);
+	for (std::uint32_t i = 0; i < workerCount; i++) {
+		workers.emplace_back(&Manager::workerLoop, this, i);
+	}
+}
+
+engine::jobs::Manager::~Manager() {
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		stopping = true;
+	}
+	sleepCondition.notify_all();
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+}
+
+void engine::jobs::Manager::Submit(JobFunction function, Priority priority, Group* group) {
+	if (group) {
+		group->remaining.fetch_add(1, std::memory_order_relaxed);
+		auto lowest = group->lowestPriority.load(std::memory_order_relaxed);
+		while ((std::uint8_t)priority > lowest && !group->lowestPriority.compare_exchange_weak(lowest, (std::uint8_t)priority, std::memory_order_relaxed)) {}
+	}
+	workQueue& queue = (currentWorker != noWorker) ? *queues[currentWorker] : *queues.back();
+	{
+		std::lock_guard<std::mutex> lock(queue.Mutex);
+		queue.Jobs[(std::size_t)priority].push_back(job{.Function = std::move(function), .JobGroup = group});
+		queue.Count.fetch_add(1, std::memory_order_release);
+	}
+	queuedJobs.fetch_add(1, std::memory_order_release);
+	if (sleepingWorkers.load(std::memory_order_acquire) > 0) {
+		// Taking the lock ensures that a worker which is about to sleep will either see the new job or be notified
+		{ std::lock_guard<std::mutex> lock(sleepMutex); }
+		sleepCondition.notify_one();
+	}
+	if (group) {
+		// A thread that is blocked on the group may be the only one left to run the new job, so it's woken to help
+		std::lock_guard<std::mutex> lock(group->mutex);
+		if (group->waiters > 0) {
+			group->submissions++;
+			group->condition.notify_all();
+		}
+	}
+}
+
+void engine::jobs::Manager::Wait(Group& group) {
+	std::uint32_t spins = 0;
+	while (!group.IsDone()) {
+		// Helping with a lower priority job than the group's could keep the waiting thread busy long after the group
+		// is done
+		auto lowestPriority = (std::size_t)group.lowestPriority.load(std::memory_order_relaxed);
+		if (tryRunJob(currentWorker, lowestPriority)) {
+			spins = 0;
+			continue;
+		}
+		if (spins < waitSpinCount) {
+			spins++;
+			std::this_thread::yield();
+			continue;
+		}
+		std::uint32_t submissions;
+		{
+			std::lock_guard<std::mutex> lock(group.mutex);
+			group.waiters++;
+			submissions = group.submissions;
+		}
+		// A job that was submitted before we registered as a waiter didn't wake us, so we check for it once more
+		bool ranJob = tryRunJob(currentWorker, lowestPriority);
+		std::unique_lock<std::mutex> lock(group.mutex);
+		if (!ranJob) {
+			group.condition.wait(lock, [&group, submissions]() { return group.IsDone() || group.submissions != submissions; });
+		}
+		group.waiters--;
+		spins = 0;
+	}
+	// The final job finishes while holding the group's lock, so taking it here ensures that the job is no longer using
+	// the group, which the caller may destroy as soon as we return
+	std::lock_guard<std::mutex> lock(group.mutex);
+}
+
+void engine::jobs::Manager::ParallelFor(std::size_t count, std::size_t minBatchSize, const std::function<void(std::size_t begin, std::size_t end)>& function, Priority priority) {
+	if (count == 0) {
+		return;
+	}
+	minBatchSize = std::max(minBatchSize, std::size_t(1));
+	std::size_t batchCount = std::min((count + minBatchSize - 1) / minBatchSize, workers.size() + 1);
+	std::size_t batchSize = (count + batchCount - 1) / batchCount;
+	Group group;
+	for (std::size_t begin = batchSize; begin < count; begin += batchSize) {
+		std::size_t end = std::min(begin + batchSize, count);
+		Submit([&function, begin, end]() { function(begin, end); }, priority, &group);
+	}
+	function(0, std::min(batchSize, count));
+	Wait(group);
+}
+
+std::uint32_t engine::jobs::Manager::GetWorkerCount() const {
+	return (std::uint32_t)workers.size();
+}
+
+void engine::jobs::Manager::workerLoop(std::uint32_t workerIndex) {
+	currentWorker = workerIndex;
+	while (!stopping.load(std::memory_order_acquire)) {
+		if (tryRunJob(workerIndex)) {
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		sleepingWorkers.fetch_add(1, std::memory_order_acq_rel);
+		sleepCondition.wait(lock, [this]() { return queuedJobs.load(std::memory_order_acquire) > 0 || stopping.load(std::memory_order_acquire); });
+		sleepingWorkers.fetch_sub(1, std::memory_order_acq_rel);
+	}
+}
+
+bool engine::jobs::Manager::tryRunJob(std::uint32_t workerIndex, std::size_t lowestPriority) {
+	job result;
+	if (!popJob(workerIndex, lowestPriority, result)) {
+		return false;
+	}
+	result.Function();
+	if (result.JobGroup) {
+		finishJob(*result.JobGroup);
+	}
+	return true;
+}
+
+bool engine::jobs::Manager::popJob(std::uint32_t workerIndex, std::size_t lowestPriority, job& result) {
+	if (queuedJobs.load(std::memory_order_acquire) == 0) {
+		return false;
+	}
+	// Every source is checked for a higher priority job before any source is checked for a lower priority job
+	auto queueCount = (std::uint32_t)queues.size();
+	std::uint32_t start = (workerIndex != noWorker) ? workerIndex : queueCount - 1;
+	for (std::size_t priority = 0; priority <= lowestPriority; priority++) {
+		for (std::uint32_t i = 0; i < queueCount; i++) {
+			std::uint32_t queueIndex = (start + i) % queueCount;
+			if (popFromQueue(*queues[queueIndex], priority, queueIndex == workerIndex, result)) {
+				queuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+void engine::jobs::Manager::finishJob(Group& group) {
+	std::uint32_t remaining = group.remaining.load(std::memory_order_relaxed);
+	while (remaining > 1) {
+		if (group.remaining.compare_exchange_weak(remaining, remaining - 1, std::memory_order_release, std::memory_order_relaxed)) {
+			return;
+		}
+	}
+	// The group may finish with this job, so the waiters are woken under the lock, after which the group is not used
+	std::lock_guard<std::mutex> lock(group.mutex);
+	group.remaining.fetch_sub(1, std::memory_order_release);
+	if (group.waiters > 0) {
+		group.condition.notify_all();
+	}
+}
+
+bool engine::jobs::Manager::popFromQueue(workQueue& queue, std::size_t priority, bool fromBack, job& result) {
+	if (queue.Count.load(std::memory_order_acquire) == 0) {
+		return false;
+	}
+	std::lock_guard<std::mutex> lock(queue.Mutex);
+	std::deque<job>& jobs = queue.Jobs[priority];
+	if (jobs.empty()) {
+		return false;
+	}
+	if (fromBack) {
+		result = std::move(jobs.back());
+		jobs.pop_back();
+	} else {
+		result = std::move(jobs.front());
+		jobs.pop_front();
+	}
+	queue.Count.fetch_sub(1, std::memory_order_release);
+	return true;
+}
+
+void engine::jobs::Initialize(std::uint32_t workerCount) {
+	GlobalManager = new Manager(workerCount);
+}
+
+void engine::jobs::Terminate() {
+	delete (GlobalManager);
+	GlobalManager = nullptr;
+}
+
+void engine::jobs::Submit(JobFunction job, Priority priority, Group* group) {
+	GlobalManager->Submit(std::move(job), priority, group);
+}
+
+void engine::jobs::Wait(Group& group) {
+	GlobalManager->Wait(group);
+}
+
+void engine::jobs::ParallelFor(std::size_t count, std::size_t minBatchSize, const std::function<void(std::size_t begin, std::size_t end)>& function, Priority priority) {
+	GlobalManager->ParallelFor(count, minBatchSize, function, priority);
+}
+
+std::uint32_t engine::jobs::GetWorkerCount() {
+	return GlobalManager->GetWorkerCount();
+}
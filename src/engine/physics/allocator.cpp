@@ -0,0 +1,120 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <engine/physics/manager.hpp>
+#include <engine/log/log.hpp>
+#include <algorithm>
+
+#include <Jolt/Core/Memory.h>
+
+// Every allocation is aligned to this, matching the alignment of Jolt's own temp allocator.
+const std::size_t tempAllocatorAlignment = JPH_RVECTOR_ALIGNMENT;
+
+static std::size_t alignSize(std::size_t size) {
+	return (size + tempAllocatorAlignment - 1) & ~(tempAllocatorAlignment - 1);
+}
+
+engine::physics::GrowingTempAllocator::GrowingTempAllocator(std::size_t blockSize, bool grow) : blockSize(alignSize(std::max(blockSize, tempAllocatorAlignment))), grow(grow) {
+	blocks.push_back(block{
+		.Data = static_cast<std::uint8_t*>(JPH::AlignedAllocate(this->blockSize, tempAllocatorAlignment)),
+		.Size = this->blockSize,
+		.Top = 0,
+	});
+	capacity = this->blockSize;
+}
+
+engine::physics::GrowingTempAllocator::~GrowingTempAllocator() {
+	JPH_ASSERT(used == 0);
+	for (block& b : blocks) {
+		JPH::AlignedFree(b.Data);
+	}
+}
+
+void* engine::physics::GrowingTempAllocator::Allocate(JPH::uint inSize) {
+	if (inSize == 0) {
+		return nullptr;
+	}
+	std::size_t size = alignSize(inSize);
+	used += size;
+	if (used > highWaterMark) {
+		highWaterMark = used;
+	}
+	if (used > stepHighWaterMark) {
+		stepHighWaterMark = used;
+	}
+	if (blocks[currentBlock].Top + size > blocks[currentBlock].Size) {
+		if (!grow) {
+			if (overflowCount.fetch_add(1, std::memory_order_relaxed) == 0) {
+				engine::log::Debug("Physics temp allocator is full, falling back to the heap");
+			}
+			return JPH::AlignedAllocate(size, tempAllocatorAlignment);
+		}
+		// Blocks after the current block are always empty, so the next block may be replaced if it's too small
+		currentBlock++;
+		if (currentBlock < blocks.size() && blocks[currentBlock].Size < size) {
+			capacity -= blocks[currentBlock].Size;
+			JPH::AlignedFree(blocks[currentBlock].Data);
+			blocks.erase(blocks.begin() + (std::ptrdiff_t)currentBlock);
+		}
+		if (currentBlock == blocks.size()) {
+			std::size_t newBlockSize = std::max(blockSize, size);
+			blocks.insert(blocks.begin() + (std::ptrdiff_t)currentBlock, block{
+				.Data = static_cast<std::uint8_t*>(JPH::AlignedAllocate(newBlockSize, tempAllocatorAlignment)),
+				.Size = newBlockSize,
+				.Top = 0,
+			});
+			capacity += newBlockSize;
+		}
+	}
+	block& current = blocks[currentBlock];
+	void* address = current.Data + current.Top;
+	current.Top += size;
+	return address;
+}
+
+void engine::physics::GrowingTempAllocator::Free(void* inAddress, JPH::uint inSize) {
+	if (inAddress == nullptr) {
+		return;
+	}
+	std::size_t size = alignSize(inSize);
+	used -= size;
+	block& current = blocks[currentBlock];
+	auto address = static_cast<std::uint8_t*>(inAddress);
+	if (address < current.Data || address >= current.Data + current.Size) {
+		// Only allocations that overflowed onto the heap live outside of the current block
+		JPH::AlignedFree(inAddress);
+		return;
+	}
+	// Allocations must be freed in the reverse order that they were made
+	JPH_ASSERT(address + size == current.Data + current.Top);
+	current.Top -= size;
+	if (current.Top == 0 && currentBlock > 0) {
+		currentBlock--;
+	}
+}
+
+std::size_t engine::physics::GrowingTempAllocator::GetHighWaterMark() const {
+	return highWaterMark;
+}
+
+std::size_t engine::physics::GrowingTempAllocator::GetCapacity() const {
+	return capacity;
+}
+
+std::uint32_t engine::physics::GrowingTempAllocator::GetOverflowCount() const {
+	return overflowCount;
+}
+
+void engine::physics::GrowingTempAllocator::ResetHighWaterMark() {
+	highWaterMark = used;
+	overflowCount = 0;
+}
+
+std::size_t engine::physics::GrowingTempAllocator::TakeStepHighWaterMark() {
+	std::size_t stepUsage = stepHighWaterMark;
+	stepHighWaterMark = used;
+	return stepUsage;
+}
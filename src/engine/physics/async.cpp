@@ -0,0 +1,154 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <engine/physics/manager.hpp>
+
+void engine::physics::Manager::Synchronize() {
+	if (asynchronous) {
+		waitForStep();
+	}
+}
+
+void engine::physics::Manager::QueueForce(const Body& body, glm::vec3 force) {
+	std::lock_guard<std::mutex> lock(commandMutex);
+	queuedCommands.AddForce(body, force);
+}
+
+void engine::physics::Manager::QueueImpulse(const Body& body, glm::vec3 impulse) {
+	std::lock_guard<std::mutex> lock(commandMutex);
+	queuedCommands.AddImpulse(body, impulse);
+}
+
+void engine::physics::Manager::QueueTeleport(const Body& body, glm::vec3 position, glm::quat rotation) {
+	std::lock_guard<std::mutex> lock(commandMutex);
+	queuedCommands.SetPositionAndRotation(body, position, rotation, true);
+}
+
+void engine::physics::Manager::QueueSpawn(const BatchBodyCreationProperties& properties) {
+	std::lock_guard<std::mutex> lock(commandMutex);
+	queuedSpawns.push_back(properties);
+}
+
+std::span<const engine::physics::Body> engine::physics::Manager::GetSpawnedBodies() {
+	return spawnedBodies;
+}
+
+void engine::physics::Manager::physicsThreadLoop() {
+	std::unique_lock<std::mutex> lock(stepMutex);
+	while (true) {
+		stepCondition.wait(lock, [this]() { return stepRequested || stopping; });
+		if (stopping) {
+			return;
+		}
+		double deltaTime = requestedDeltaTime;
+		lock.unlock();
+		simulate(deltaTime);
+		captureSnapshot();
+		lock.lock();
+		stepRequested = false;
+		stepCondition.notify_all();
+	}
+}
+
+void engine::physics::Manager::waitForStep() {
+	std::unique_lock<std::mutex> lock(stepMutex);
+	stepCondition.wait(lock, [this]() { return !stepRequested; });
+}
+
+void engine::physics::Manager::captureSnapshot() {
+	std::uint32_t backSnapshot = frontSnapshot ^ 1;
+	std::vector<snapshotTransform>& snapshot = snapshots[backSnapshot];
+	if (snapshot.empty()) {
+		snapshot.resize(physicsSystem->GetMaxBodies());
+	}
+	std::uint64_t lastStep = stepCount - 1;
+	const JPH::BodyLockInterfaceNoLock& lockInterface = physicsSystem->GetBodyLockInterfaceNoLock();
+	auto capture = [&](JPH::BodyID bodyID) {
+		const JPH::Body* body = lockInterface.TryGetBody(bodyID);
+		if (!body) {
+			return;
+		}
+		snapshotTransform& entry = snapshot[bodyID.GetIndex()];
+		entry.BodyID = bodyID;
+		entry.Position = body->GetPosition();
+		entry.Rotation = body->GetRotation();
+		if (!previousTransforms.empty() && previousTransforms[bodyID.GetIndex()].Step == lastStep) {
+			entry.PreviousPosition = previousTransforms[bodyID.GetIndex()].Position;
+			entry.PreviousRotation = previousTransforms[bodyID.GetIndex()].Rotation;
+		} else {
+			entry.PreviousPosition = entry.Position;
+			entry.PreviousRotation = entry.Rotation;
+		}
+	};
+	// Bodies that were active when this snapshot was last captured may have fallen asleep since, and their final
+	// transform has only been captured into the other snapshot
+	for (JPH::BodyID bodyID : snapshotBodies[backSnapshot]) {
+		capture(bodyID);
+	}
+	physicsSystem->GetActiveBodies(snapshotBodies[backSnapshot]);
+	for (JPH::BodyID bodyID : snapshotBodies[backSnapshot]) {
+		capture(bodyID);
+	}
+}
+
+void engine::physics::Manager::captureUncapturedBodies() {
+	if (uncapturedBodies.empty()) {
+		return;
+	}
+	const JPH::BodyLockInterfaceNoLock& lockInterface = physicsSystem->GetBodyLockInterfaceNoLock();
+	for (std::vector<snapshotTransform>& snapshot : snapshots) {
+		if (snapshot.empty()) {
+			snapshot.resize(physicsSystem->GetMaxBodies());
+		}
+		for (JPH::BodyID bodyID : uncapturedBodies) {
+			const JPH::Body* body = lockInterface.TryGetBody(bodyID);
+			if (!body) {
+				continue;
+			}
+			// The body was placed rather than simulated, so there is nothing to interpolate from
+			snapshotTransform& entry = snapshot[bodyID.GetIndex()];
+			entry.BodyID = bodyID;
+			entry.Position = body->GetPosition();
+			entry.Rotation = body->GetRotation();
+			entry.PreviousPosition = entry.Position;
+			entry.PreviousRotation = entry.Rotation;
+		}
+	}
+	uncapturedBodies.clear();
+}
+
+const engine::physics::Manager::snapshotTransform* engine::physics::Manager::getSnapshot(JPH::BodyID bodyID) const {
+	const std::vector<snapshotTransform>& snapshot = snapshots[frontSnapshot];
+	if (snapshot.empty() || bodyID.IsInvalid() || bodyID.GetIndex() >= snapshot.size()) {
+		return nullptr;
+	}
+	const snapshotTransform& entry = snapshot[bodyID.GetIndex()];
+	return (entry.BodyID == bodyID) ? &entry : nullptr;
+}
+
+void engine::physics::Synchronize() {
+	GetCurrentManager()->Synchronize();
+}
+
+void engine::physics::QueueForce(const Body& body, glm::vec3 force) {
+	GetCurrentManager()->QueueForce(body, force);
+}
+
+void engine::physics::QueueImpulse(const Body& body, glm::vec3 impulse) {
+	GetCurrentManager()->QueueImpulse(body, impulse);
+}
+
+void engine::physics::QueueTeleport(const Body& body, glm::vec3 position, glm::quat rotation) {
+	GetCurrentManager()->QueueTeleport(body, position, rotation);
+}
+
+void engine::physics::QueueSpawn(const BatchBodyCreationProperties& properties) {
+	GetCurrentManager()->QueueSpawn(properties);
+}
+
+std::span<const engine::physics::Body> engine::physics::GetSpawnedBodies() {
+	return GetCurrentManager()->GetSpawnedBodies();
+}
@@ -8,12 +8,14 @@
 
 static_assert(sizeof(JPH::BodyID) == sizeof(std::uint32_t), "Expected BodyID to be the same size as an uint32");
 
-engine::physics::Body::Body(std::uint32_t id, bool destructible) : id(id), destructible(destructible) {}
+engine::physics::Body::Body() : id(JPH::BodyID::cInvalidBodyID), manager(nullptr), destructible(false) {}
+
+engine::physics::Body::Body(std::uint32_t id, Manager* manager, bool destructible) : id(id), manager(manager), destructible(destructible) {}
 
 engine::physics::Body::~Body() {
 	if (destructible) {
 		auto bodyID = static_cast<JPH::BodyID>(id);
-		auto& bodyInterface = engine::physics::GlobalManager->physicsSystem->GetBodyInterface();
+		auto& bodyInterface = manager->physicsSystem->GetBodyInterface();
 		bodyInterface.RemoveBody(bodyID);
 		bodyInterface.DestroyBody(bodyID);
 	}
@@ -21,12 +23,16 @@ engine::physics::Body::~Body() {
 
 void engine::physics::Body::Activate() const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	engine::physics::GlobalManager->physicsSystem->GetBodyInterface().ActivateBody(bodyID);
+	manager->physicsSystem->GetBodyInterface().ActivateBody(bodyID);
 }
 
 void engine::physics::Body::Deactivate() const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	engine::physics::GlobalManager->physicsSystem->GetBodyInterface().DeactivateBody(bodyID);
+	manager->physicsSystem->GetBodyInterface().DeactivateBody(bodyID);
+}
+
+bool engine::physics::Body::IsValid() const {
+	return id != JPH::BodyID::cInvalidBodyID;
 }
 
 std::uint32_t engine::physics::Body::GetID() const {
@@ -35,22 +41,22 @@ std::uint32_t engine::physics::Body::GetID() const {
 
 glm::vec3 engine::physics::Body::GetPosition() const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	return toGLM(engine::physics::GlobalManager->physicsSystem->GetBodyInterface().GetPosition(bodyID));
+	return toGLM(manager->physicsSystem->GetBodyInterface().GetPosition(bodyID));
 }
 
 glm::vec3 engine::physics::Body::GetCenterOfMassPosition() const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	return toGLM(engine::physics::GlobalManager->physicsSystem->GetBodyInterface().GetCenterOfMassPosition(bodyID));
+	return toGLM(manager->physicsSystem->GetBodyInterface().GetCenterOfMassPosition(bodyID));
 }
 
 glm::vec3 engine::physics::Body::GetLinearVelocity() const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	return toGLM(engine::physics::GlobalManager->physicsSystem->GetBodyInterface().GetLinearVelocity(bodyID));
+	return toGLM(manager->physicsSystem->GetBodyInterface().GetLinearVelocity(bodyID));
 }
 
 float engine::physics::Body::GetMaxLinearVelocity() const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	auto body = engine::physics::GlobalManager->physicsSystem->GetBodyLockInterface().TryGetBody(bodyID);
+	auto body = manager->physicsSystem->GetBodyLockInterface().TryGetBody(bodyID);
 #if !defined(NDEBUG) || defined(_DEBUG)
 	if (!body) {
 		engine::log::Debug("Could not get the physics body when querying GetMaxLinearVelocity");
@@ -62,12 +68,12 @@ float engine::physics::Body::GetMaxLinearVelocity() const {
 
 glm::vec3 engine::physics::Body::GetAngularVelocity() const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	return toGLM(engine::physics::GlobalManager->physicsSystem->GetBodyInterface().GetAngularVelocity(bodyID));
+	return toGLM(manager->physicsSystem->GetBodyInterface().GetAngularVelocity(bodyID));
 }
 
 float engine::physics::Body::GetMaxAngularVelocity() const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	auto body = engine::physics::GlobalManager->physicsSystem->GetBodyLockInterface().TryGetBody(bodyID);
+	auto body = manager->physicsSystem->GetBodyLockInterface().TryGetBody(bodyID);
 #if !defined(NDEBUG) || defined(_DEBUG)
 	if (!body) {
 		engine::log::Debug("Could not get the physics body when querying GetMaxAngularVelocity");
@@ -79,7 +85,7 @@ float engine::physics::Body::GetMaxAngularVelocity() const {
 
 glm::quat engine::physics::Body::GetRotation() const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	return toGLM(engine::physics::GlobalManager->physicsSystem->GetBodyInterface().GetRotation(bodyID));
+	return toGLM(manager->physicsSystem->GetBodyInterface().GetRotation(bodyID));
 }
 
 glm::mat4 engine::physics::Body::GetRotationMatrix() const {
@@ -88,17 +94,17 @@ glm::mat4 engine::physics::Body::GetRotationMatrix() const {
 
 glm::vec3 engine::physics::Body::GetScale() const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	return toGLM(engine::physics::GlobalManager->physicsSystem->GetBodyInterface().GetShape(bodyID)->GetLocalBounds().GetSize());
+	return toGLM(manager->physicsSystem->GetBodyInterface().GetShape(bodyID)->GetLocalBounds().GetSize());
 }
 
 glm::mat4 engine::physics::Body::GetTransform() const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	return toGLM(engine::physics::GlobalManager->physicsSystem->GetBodyInterface().GetWorldTransform(bodyID));
+	return toGLM(manager->physicsSystem->GetBodyInterface().GetWorldTransform(bodyID));
 }
 
 glm::mat4 engine::physics::Body::GetScaledTransform() const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	auto shape = engine::physics::GlobalManager->physicsSystem->GetBodyInterface().GetTransformedShape(bodyID);
+	auto shape = manager->physicsSystem->GetBodyInterface().GetTransformedShape(bodyID);
 	auto scale = shape.mShape->GetLocalBounds().GetSize();
 	JPH::RMat44 transform = JPH::RMat44::sRotation(shape.mShapeRotation).PreScaled(scale);
 	transform.SetTranslation(shape.mShapePositionCOM - transform.Multiply3x3(shape.mShape->GetCenterOfMass()));
@@ -107,7 +113,7 @@ glm::mat4 engine::physics::Body::GetScaledTransform() const {
 
 glm::vec3 engine::physics::Body::GetBoundingBox(glm::vec3& min, glm::vec3& max) const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	auto boundingBox = engine::physics::GlobalManager->physicsSystem->GetBodyInterface().GetTransformedShape(bodyID).mShape->GetLocalBounds();
+	auto boundingBox = manager->physicsSystem->GetBodyInterface().GetTransformedShape(bodyID).mShape->GetLocalBounds();
 	min = toGLM(boundingBox.mMin);
 	max = toGLM(boundingBox.mMax);
 	return toGLM(boundingBox.GetSize());
@@ -115,32 +121,32 @@ glm::vec3 engine::physics::Body::GetBoundingBox(glm::vec3& min, glm::vec3& max)
 
 float engine::physics::Body::GetFriction() const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	return engine::physics::GlobalManager->physicsSystem->GetBodyInterface().GetFriction(bodyID);
+	return manager->physicsSystem->GetBodyInterface().GetFriction(bodyID);
 }
 
 float engine::physics::Body::GetGravityFactor() const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	return engine::physics::GlobalManager->physicsSystem->GetBodyInterface().GetGravityFactor(bodyID);
+	return manager->physicsSystem->GetBodyInterface().GetGravityFactor(bodyID);
 }
 
 float engine::physics::Body::GetRestitution() const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	return engine::physics::GlobalManager->physicsSystem->GetBodyInterface().GetRestitution(bodyID);
+	return manager->physicsSystem->GetBodyInterface().GetRestitution(bodyID);
 }
 
 engine::physics::MotionType engine::physics::Body::GetMotionType() const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	return toGLM(engine::physics::GlobalManager->physicsSystem->GetBodyInterface().GetMotionType(bodyID));
+	return toGLM(manager->physicsSystem->GetBodyInterface().GetMotionType(bodyID));
 }
 
 engine::physics::MotionQuality engine::physics::Body::GetMotionQuality() const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	return toGLM(engine::physics::GlobalManager->physicsSystem->GetBodyInterface().GetMotionQuality(bodyID));
+	return toGLM(manager->physicsSystem->GetBodyInterface().GetMotionQuality(bodyID));
 }
 
 engine::physics::Shape engine::physics::Body::GetShape() const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	auto body = engine::physics::GlobalManager->physicsSystem->GetBodyLockInterface().TryGetBody(bodyID);
+	auto body = manager->physicsSystem->GetBodyLockInterface().TryGetBody(bodyID);
 #if !defined(NDEBUG) || defined(_DEBUG)
 	if (!body) {
 		engine::log::Debug("Could not get the physics body when querying GetShape");
@@ -151,32 +157,32 @@ engine::physics::Shape engine::physics::Body::GetShape() const {
 }
 
 engine::physics::Body* engine::physics::Body::GetCopy() const {
-	return new Body(id, false);
+	return new Body(id, manager, false);
 }
 
 bool engine::physics::Body::IsActive() const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	return engine::physics::GlobalManager->physicsSystem->GetBodyInterface().IsActive(bodyID);
+	return manager->physicsSystem->GetBodyInterface().IsActive(bodyID);
 }
 
 bool engine::physics::Body::IsDynamic() const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	return engine::physics::GlobalManager->physicsSystem->GetBodyInterface().GetMotionType(bodyID) == JPH::EMotionType::Dynamic;
+	return manager->physicsSystem->GetBodyInterface().GetMotionType(bodyID) == JPH::EMotionType::Dynamic;
 }
 
 bool engine::physics::Body::IsKinematic() const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	return engine::physics::GlobalManager->physicsSystem->GetBodyInterface().GetMotionType(bodyID) == JPH::EMotionType::Kinematic;
+	return manager->physicsSystem->GetBodyInterface().GetMotionType(bodyID) == JPH::EMotionType::Kinematic;
 }
 
 bool engine::physics::Body::IsStatic() const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	return engine::physics::GlobalManager->physicsSystem->GetBodyInterface().GetMotionType(bodyID) == JPH::EMotionType::Static;
+	return manager->physicsSystem->GetBodyInterface().GetMotionType(bodyID) == JPH::EMotionType::Static;
 }
 
 bool engine::physics::Body::IsSensor() const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	auto body = engine::physics::GlobalManager->physicsSystem->GetBodyLockInterface().TryGetBody(bodyID);
+	auto body = manager->physicsSystem->GetBodyLockInterface().TryGetBody(bodyID);
 #if !defined(NDEBUG) || defined(_DEBUG)
 	if (!body) {
 		engine::log::Debug("Could not get the physics body when querying IsSensor");
@@ -186,6 +192,18 @@ bool engine::physics::Body::IsSensor() const {
 	return body->IsSensor();
 }
 
+std::uint64_t engine::physics::Body::GetUserData() const {
+	auto bodyID = static_cast<JPH::BodyID>(id);
+	auto body = manager->physicsSystem->GetBodyLockInterface().TryGetBody(bodyID);
+#if !defined(NDEBUG) || defined(_DEBUG)
+	if (!body) {
+		engine::log::Debug("Could not get the physics body when querying GetUserData");
+		return 0;
+	}
+#endif //!defined(NDEBUG) || defined(_DEBUG)
+	return body->GetUserData();
+}
+
 bool engine::physics::Body::TestRay(glm::vec3 origin, glm::vec3 direction, float magnitude) const {
 	glm::vec3 contactPoint;
 	return TestRay(origin, direction, magnitude, contactPoint);
@@ -201,11 +219,11 @@ bool engine::physics::Body::TestRay(glm::vec3 origin, glm::vec3 directionWithMag
 }
 
 bool engine::physics::Body::TestRay(glm::vec3 origin, glm::vec3 directionWithMagnitude, glm::vec3& contactPoint) const {
-	JPH::RayCast ray{toJPH(origin), toJPH(directionWithMagnitude)};
-	JPH::ClosestHitCollisionCollector<JPH::RayCastBodyCollector> collector;
-	engine::physics::GlobalManager->physicsSystem->GetBroadPhaseQuery().CastRay(ray, collector);
-	if (collector.HadHit() && collector.mHit.mBodyID.GetIndexAndSequenceNumber() == id) {
-		contactPoint = origin + (collector.mHit.mFraction * (directionWithMagnitude));
+	JPH::RRayCast ray{toJPH(origin), toJPH(directionWithMagnitude)};
+	JPH::RayCastResult hit;
+	manager->physicsSystem->GetNarrowPhaseQuery().CastRay(ray, hit);
+	if (!hit.mBodyID.IsInvalid() && hit.mBodyID.GetIndexAndSequenceNumber() == id) {
+		contactPoint = origin + (hit.mFraction * (directionWithMagnitude));
 		return true;
 	}
 	return false;
@@ -214,17 +232,17 @@ bool engine::physics::Body::TestRay(glm::vec3 origin, glm::vec3 directionWithMag
 void engine::physics::Body::SetPosition(glm::vec3 position, bool forceActivate) const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
 	auto activation = forceActivate ? JPH::EActivation::Activate : JPH::EActivation::DontActivate;
-	engine::physics::GlobalManager->physicsSystem->GetBodyInterface().SetPosition(bodyID, toJPH(position), activation);
+	manager->physicsSystem->GetBodyInterface().SetPosition(bodyID, toJPH(position), activation);
 }
 
 void engine::physics::Body::SetLinearVelocity(glm::vec3 velocity) const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	engine::physics::GlobalManager->physicsSystem->GetBodyInterface().SetLinearVelocity(bodyID, toJPH(velocity));
+	manager->physicsSystem->GetBodyInterface().SetLinearVelocity(bodyID, toJPH(velocity));
 }
 
 void engine::physics::Body::SetLinearVelocityClamped(glm::vec3 velocity) const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	auto body = engine::physics::GlobalManager->physicsSystem->GetBodyLockInterface().TryGetBody(bodyID);
+	auto body = manager->physicsSystem->GetBodyLockInterface().TryGetBody(bodyID);
 #if !defined(NDEBUG) || defined(_DEBUG)
 	if (!body) {
 		engine::log::Debug("Could not get the physics body when setting SetLinearVelocityClamped");
@@ -236,7 +254,7 @@ void engine::physics::Body::SetLinearVelocityClamped(glm::vec3 velocity) const {
 
 void engine::physics::Body::SetMaxLinearVelocity(float velocity) const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	auto body = engine::physics::GlobalManager->physicsSystem->GetBodyLockInterface().TryGetBody(bodyID);
+	auto body = manager->physicsSystem->GetBodyLockInterface().TryGetBody(bodyID);
 #if !defined(NDEBUG) || defined(_DEBUG)
 	if (!body) {
 		engine::log::Debug("Could not get the physics body when setting SetMaxLinearVelocity");
@@ -248,12 +266,12 @@ void engine::physics::Body::SetMaxLinearVelocity(float velocity) const {
 
 void engine::physics::Body::SetAngularVelocity(glm::vec3 velocity) const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	engine::physics::GlobalManager->physicsSystem->GetBodyInterface().SetAngularVelocity(bodyID, toJPH(velocity));
+	manager->physicsSystem->GetBodyInterface().SetAngularVelocity(bodyID, toJPH(velocity));
 }
 
 void engine::physics::Body::SetAngularVelocityClamped(glm::vec3 velocity) const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	auto body = engine::physics::GlobalManager->physicsSystem->GetBodyLockInterface().TryGetBody(bodyID);
+	auto body = manager->physicsSystem->GetBodyLockInterface().TryGetBody(bodyID);
 #if !defined(NDEBUG) || defined(_DEBUG)
 	if (!body) {
 		engine::log::Debug("Could not get the physics body when setting SetAngularVelocityClamped");
@@ -265,7 +283,7 @@ void engine::physics::Body::SetAngularVelocityClamped(glm::vec3 velocity) const
 
 void engine::physics::Body::SetMaxAngularVelocity(float velocity) const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	auto body = engine::physics::GlobalManager->physicsSystem->GetBodyLockInterface().TryGetBody(bodyID);
+	auto body = manager->physicsSystem->GetBodyLockInterface().TryGetBody(bodyID);
 #if !defined(NDEBUG) || defined(_DEBUG)
 	if (!body) {
 		engine::log::Debug("Could not get the physics body when setting SetMaxAngularVelocity");
@@ -278,32 +296,32 @@ void engine::physics::Body::SetMaxAngularVelocity(float velocity) const {
 void engine::physics::Body::SetRotation(glm::quat rotation, bool forceActivate) const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
 	auto activation = forceActivate ? JPH::EActivation::Activate : JPH::EActivation::DontActivate;
-	engine::physics::GlobalManager->physicsSystem->GetBodyInterface().SetRotation(bodyID, toJPH(rotation), activation);
+	manager->physicsSystem->GetBodyInterface().SetRotation(bodyID, toJPH(rotation), activation);
 }
 
 void engine::physics::Body::SetFriction(float friction) const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	engine::physics::GlobalManager->physicsSystem->GetBodyInterface().SetFriction(bodyID, friction);
+	manager->physicsSystem->GetBodyInterface().SetFriction(bodyID, friction);
 }
 
 void engine::physics::Body::SetGravityFactor(float gravityFactor) const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	engine::physics::GlobalManager->physicsSystem->GetBodyInterface().SetGravityFactor(bodyID, gravityFactor);
+	manager->physicsSystem->GetBodyInterface().SetGravityFactor(bodyID, gravityFactor);
 }
 
 void engine::physics::Body::SetRestitution(float restitution) const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	engine::physics::GlobalManager->physicsSystem->GetBodyInterface().SetRestitution(bodyID, restitution);
+	manager->physicsSystem->GetBodyInterface().SetRestitution(bodyID, restitution);
 }
 
 void engine::physics::Body::SetMotionQuality(MotionQuality quality) const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	engine::physics::GlobalManager->physicsSystem->GetBodyInterface().SetMotionQuality(bodyID, toJPH(quality));
+	manager->physicsSystem->GetBodyInterface().SetMotionQuality(bodyID, toJPH(quality));
 }
 
 void engine::physics::Body::SetIsSensor(bool isSensor) const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	auto body = engine::physics::GlobalManager->physicsSystem->GetBodyLockInterface().TryGetBody(bodyID);
+	auto body = manager->physicsSystem->GetBodyLockInterface().TryGetBody(bodyID);
 #if !defined(NDEBUG) || defined(_DEBUG)
 	if (!body) {
 		engine::log::Debug("Could not get the physics body when setting SetIsSensor");
@@ -313,37 +331,49 @@ void engine::physics::Body::SetIsSensor(bool isSensor) const {
 	body->SetIsSensor(isSensor);
 }
 
+void engine::physics::Body::SetUserData(std::uint64_t userData) const {
+	auto bodyID = static_cast<JPH::BodyID>(id);
+	auto body = manager->physicsSystem->GetBodyLockInterface().TryGetBody(bodyID);
+#if !defined(NDEBUG) || defined(_DEBUG)
+	if (!body) {
+		engine::log::Debug("Could not get the physics body when setting SetUserData");
+		return;
+	}
+#endif //!defined(NDEBUG) || defined(_DEBUG)
+	body->SetUserData(userData);
+}
+
 void engine::physics::Body::AddForce(glm::vec3 force) const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	engine::physics::GlobalManager->physicsSystem->GetBodyInterface().AddForce(bodyID, toJPH(force));
+	manager->physicsSystem->GetBodyInterface().AddForce(bodyID, toJPH(force));
 }
 
 void engine::physics::Body::AddForce(glm::vec3 force, glm::vec3 point) const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	engine::physics::GlobalManager->physicsSystem->GetBodyInterface().AddForce(bodyID, toJPH(force), toJPH(point));
+	manager->physicsSystem->GetBodyInterface().AddForce(bodyID, toJPH(force), toJPH(point));
 }
 
 void engine::physics::Body::AddImpulse(glm::vec3 impulse) const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	engine::physics::GlobalManager->physicsSystem->GetBodyInterface().AddImpulse(bodyID, toJPH(impulse));
+	manager->physicsSystem->GetBodyInterface().AddImpulse(bodyID, toJPH(impulse));
 }
 
 void engine::physics::Body::AddImpulse(glm::vec3 impulse, glm::vec3 point) const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	engine::physics::GlobalManager->physicsSystem->GetBodyInterface().AddImpulse(bodyID, toJPH(impulse), toJPH(point));
+	manager->physicsSystem->GetBodyInterface().AddImpulse(bodyID, toJPH(impulse), toJPH(point));
 }
 
 void engine::physics::Body::AddAngularImpulse(glm::vec3 impulse) const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	engine::physics::GlobalManager->physicsSystem->GetBodyInterface().AddAngularImpulse(bodyID, toJPH(impulse));
+	manager->physicsSystem->GetBodyInterface().AddAngularImpulse(bodyID, toJPH(impulse));
 }
 
 void engine::physics::Body::AddTorque(glm::vec3 torque) const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	engine::physics::GlobalManager->physicsSystem->GetBodyInterface().AddTorque(bodyID, toJPH(torque));
+	manager->physicsSystem->GetBodyInterface().AddTorque(bodyID, toJPH(torque));
 }
 
 void engine::physics::Body::MoveKinematic(glm::vec3 position, glm::quat rotation, float seconds) const {
 	auto bodyID = static_cast<JPH::BodyID>(id);
-	engine::physics::GlobalManager->physicsSystem->GetBodyInterface().MoveKinematic(bodyID, toJPH(position), toJPH(rotation), seconds);
+	manager->physicsSystem->GetBodyInterface().MoveKinematic(bodyID, toJPH(position), toJPH(rotation), seconds);
 }
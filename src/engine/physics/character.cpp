@@ -6,7 +6,13 @@
 
 #include <engine/physics/manager.hpp>
 
-engine::physics::Character::Character(void* character) : character(character) {
+// Each job thread reuses its own allocator across updates, as the allocator used by the physics step cannot be shared
+// between threads
+const std::uint32_t characterTempAllocatorSize = 256 * 1024;
+// Characters are cheap to update, so each job should move several of them to amortize the cost of scheduling
+const std::size_t minCharactersPerJob = 16;
+
+engine::physics::Character::Character(void* character, Manager* manager) : character(character), manager(manager) {
 	auto jphCharacter = reinterpret_cast<JPH::Character*>(this->character);
 	jphCharacter->AddToPhysicsSystem(JPH::EActivation::Activate);
 }
@@ -21,7 +27,7 @@ engine::physics::Character::~Character() {
 engine::physics::Body engine::physics::Character::GetBody() {
 	auto character = reinterpret_cast<JPH::Character*>(this->character);
 	auto bodyID = character->GetBodyID().GetIndexAndSequenceNumber();
-	return Body(bodyID, false);
+	return Body(bodyID, manager, false);
 }
 
 engine::physics::GroundState engine::physics::Character::GetGroundState() {
@@ -37,4 +43,75 @@ void engine::physics::Character::PostSimulation() {
 glm::vec3 engine::physics::Character::GetGroundNormal() {
 	auto character = reinterpret_cast<JPH::Character*>(this->character);
 	return toGLM(character->GetGroundNormal());
-}
\ No newline at end of file
+}
+
+engine::physics::VirtualCharacter::VirtualCharacter(void* character, float gravityFactor, Manager* manager)
+	: character(character), gravityFactor(gravityFactor), manager(manager) {}
+
+engine::physics::VirtualCharacter::~VirtualCharacter() {
+	delete reinterpret_cast<JPH::CharacterVirtual*>(character);
+}
+
+glm::vec3 engine::physics::VirtualCharacter::GetPosition() const {
+	auto character = reinterpret_cast<const JPH::CharacterVirtual*>(this->character);
+	return toGLM(character->GetPosition());
+}
+
+void engine::physics::VirtualCharacter::SetPosition(glm::vec3 position) {
+	auto character = reinterpret_cast<JPH::CharacterVirtual*>(this->character);
+	character->SetPosition(toJPH(position));
+}
+
+glm::quat engine::physics::VirtualCharacter::GetRotation() const {
+	auto character = reinterpret_cast<const JPH::CharacterVirtual*>(this->character);
+	return toGLM(character->GetRotation());
+}
+
+void engine::physics::VirtualCharacter::SetRotation(glm::quat rotation) {
+	auto character = reinterpret_cast<JPH::CharacterVirtual*>(this->character);
+	character->SetRotation(toJPH(rotation));
+}
+
+glm::vec3 engine::physics::VirtualCharacter::GetLinearVelocity() const {
+	auto character = reinterpret_cast<const JPH::CharacterVirtual*>(this->character);
+	return toGLM(character->GetLinearVelocity());
+}
+
+void engine::physics::VirtualCharacter::SetLinearVelocity(glm::vec3 velocity) {
+	auto character = reinterpret_cast<JPH::CharacterVirtual*>(this->character);
+	character->SetLinearVelocity(toJPH(velocity));
+}
+
+engine::physics::GroundState engine::physics::VirtualCharacter::GetGroundState() const {
+	auto character = reinterpret_cast<const JPH::CharacterVirtual*>(this->character);
+	return toGLM(character->GetGroundState());
+}
+
+glm::vec3 engine::physics::VirtualCharacter::GetGroundNormal() const {
+	auto character = reinterpret_cast<const JPH::CharacterVirtual*>(this->character);
+	return toGLM(character->GetGroundNormal());
+}
+
+void engine::physics::Manager::UpdateCharacters(std::span<VirtualCharacter* const> characters, float deltaTime) {
+	JPH::Vec3 gravity = physicsSystem->GetGravity();
+	auto broadPhaseFilter = physicsSystem->GetDefaultBroadPhaseLayerFilter(Layers::MOVING);
+	auto objectFilter = physicsSystem->GetDefaultLayerFilter(Layers::MOVING);
+	JPH::BodyFilter bodyFilter;
+	// Each character only reads the physics system and pushes bodies through the locking body interface, so characters
+	// may be moved in parallel as long as the physics system is not being stepped
+	engine::jobs::ParallelFor(characters.size(), minCharactersPerJob, [&](std::size_t begin, std::size_t end) {
+		static thread_local JPH::TempAllocatorImpl tempAllocator(characterTempAllocatorSize);
+		for (std::size_t i = begin; i < end; i++) {
+			VirtualCharacter* virtualCharacter = characters[i];
+			auto character = reinterpret_cast<JPH::CharacterVirtual*>(virtualCharacter->character);
+			if (character->GetGroundState() != JPH::CharacterBase::EGroundState::OnGround) {
+				character->SetLinearVelocity(character->GetLinearVelocity() + gravity * (virtualCharacter->gravityFactor * deltaTime));
+			}
+			character->Update(deltaTime, gravity, broadPhaseFilter, objectFilter, bodyFilter, tempAllocator);
+		}
+	}, engine::jobs::Priority::High);
+}
+
+void engine::physics::UpdateCharacters(std::span<VirtualCharacter* const> characters, float deltaTime) {
+	GetCurrentManager()->UpdateCharacters(characters, deltaTime);
+}
@@ -0,0 +1,152 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <engine/physics/manager.hpp>
+#include <algorithm>
+
+void engine::physics::CommandBuffer::AddForce(const Body& body, glm::vec3 force) {
+	commands.push_back(command{.Type = command::Kind::Force, .BodyID = body.GetID(), .Vector = force});
+}
+
+void engine::physics::CommandBuffer::AddImpulse(const Body& body, glm::vec3 impulse) {
+	commands.push_back(command{.Type = command::Kind::Impulse, .BodyID = body.GetID(), .Vector = impulse});
+}
+
+void engine::physics::CommandBuffer::SetLinearVelocity(const Body& body, glm::vec3 velocity) {
+	commands.push_back(command{.Type = command::Kind::LinearVelocity, .BodyID = body.GetID(), .Vector = velocity});
+}
+
+void engine::physics::CommandBuffer::MoveKinematic(const Body& body, glm::vec3 position, glm::quat rotation, float seconds) {
+	commands.push_back(command{.Type = command::Kind::MoveKinematic, .BodyID = body.GetID(), .Vector = position, .Rotation = rotation, .Seconds = seconds});
+}
+
+void engine::physics::CommandBuffer::SetPosition(const Body& body, glm::vec3 position, bool forceActivate) {
+	commands.push_back(command{.Type = command::Kind::Position, .Activate = forceActivate, .BodyID = body.GetID(), .Vector = position});
+}
+
+void engine::physics::CommandBuffer::SetPositionAndRotation(const Body& body, glm::vec3 position, glm::quat rotation, bool forceActivate) {
+	commands.push_back(command{.Type = command::Kind::PositionAndRotation, .Activate = forceActivate, .BodyID = body.GetID(), .Vector = position, .Rotation = rotation});
+}
+
+void engine::physics::CommandBuffer::Reserve(std::size_t count) {
+	commands.reserve(count);
+}
+
+void engine::physics::CommandBuffer::Clear() {
+	commands.clear();
+}
+
+std::size_t engine::physics::CommandBuffer::Size() const {
+	return commands.size();
+}
+
+void engine::physics::Manager::SubmitCommands(CommandBuffer& buffer) {
+	std::lock_guard<std::mutex> lock(commandMutex);
+	if (queuedCommands.commands.empty()) {
+		// Swapping hands the queue's spare allocation back to the caller's buffer
+		std::swap(queuedCommands.commands, buffer.commands);
+	} else {
+		queuedCommands.commands.insert(queuedCommands.commands.end(), buffer.commands.begin(), buffer.commands.end());
+	}
+	buffer.commands.clear();
+}
+
+void engine::physics::Manager::applyCommands() {
+	{
+		std::lock_guard<std::mutex> lock(commandMutex);
+		std::swap(queuedCommands.commands, applyingCommands.commands);
+		std::swap(queuedSpawns, applyingSpawns);
+	}
+	std::vector<CommandBuffer::command>& commands = applyingCommands.commands;
+	// Sorting by index visits the bodies in the order that they're stored, and groups the commands for each body so that
+	// each body is only looked up once. The sort is stable so that each body's commands keep their recorded order.
+	auto byBody = [](const CommandBuffer::command& lhs, const CommandBuffer::command& rhs) {
+		std::uint32_t lhsIndex = JPH::BodyID(lhs.BodyID).GetIndex();
+		std::uint32_t rhsIndex = JPH::BodyID(rhs.BodyID).GetIndex();
+		return (lhsIndex != rhsIndex) ? lhsIndex < rhsIndex : lhs.BodyID < rhs.BodyID;
+	};
+	if (!std::is_sorted(commands.begin(), commands.end(), byBody)) {
+		std::stable_sort(commands.begin(), commands.end(), byBody);
+	}
+	// Commands are applied between steps on the thread that steps the physics, so the bodies do not need to be locked
+	const JPH::BodyLockInterfaceNoLock& lockInterface = physicsSystem->GetBodyLockInterfaceNoLock();
+	JPH::BodyInterface& bodyInterface = physicsSystem->GetBodyInterfaceNoLock();
+	activatingBodies.clear();
+	for (size_t i = 0; i < commands.size();) {
+		std::uint32_t id = commands[i].BodyID;
+		// Invalid bodies from a batch that could not be created have no slot to look up
+		JPH::Body* body = id == JPH::BodyID::cInvalidBodyID ? nullptr : lockInterface.TryGetBody(JPH::BodyID(id));
+		bool activate = false;
+		bool moved = false;
+		for (; i < commands.size() && commands[i].BodyID == id; i++) {
+			// Bodies that were destroyed after their commands were recorded are skipped
+			if (!body) {
+				continue;
+			}
+			const CommandBuffer::command& cmd = commands[i];
+			switch (cmd.Type) {
+				case CommandBuffer::command::Kind::Force:
+					if (body->IsDynamic()) {
+						body->AddForce(toJPH(cmd.Vector));
+						activate = true;
+					}
+					break;
+				case CommandBuffer::command::Kind::Impulse:
+					if (body->IsDynamic()) {
+						body->AddImpulse(toJPH(cmd.Vector));
+						activate = true;
+					}
+					break;
+				case CommandBuffer::command::Kind::LinearVelocity:
+					if (!body->IsStatic()) {
+						body->SetLinearVelocityClamped(toJPH(cmd.Vector));
+						activate = activate || cmd.Vector != glm::vec3(0.0f);
+					}
+					break;
+				case CommandBuffer::command::Kind::MoveKinematic:
+					if (!body->IsStatic()) {
+						body->MoveKinematic(toJPH(cmd.Vector), toJPH(cmd.Rotation), cmd.Seconds);
+						activate = activate || !body->GetLinearVelocity().IsNearZero() || !body->GetAngularVelocity().IsNearZero();
+					}
+					break;
+				case CommandBuffer::command::Kind::Position:
+					bodyInterface.SetPosition(body->GetID(), toJPH(cmd.Vector), JPH::EActivation::DontActivate);
+					activate = activate || cmd.Activate;
+					moved = true;
+					break;
+				case CommandBuffer::command::Kind::PositionAndRotation:
+					bodyInterface.SetPositionAndRotation(body->GetID(), toJPH(cmd.Vector), toJPH(cmd.Rotation), JPH::EActivation::DontActivate);
+					activate = activate || cmd.Activate;
+					moved = true;
+					break;
+			}
+		}
+		if (body && activate && !body->IsStatic() && !body->IsActive()) {
+			activatingBodies.push_back(body->GetID());
+		}
+		// Teleported bodies that stay asleep would otherwise keep their old transform in the snapshots
+		if (body && moved && asynchronous) {
+			uncapturedBodies.push_back(body->GetID());
+		}
+	}
+	// Activating every body at once only takes the activation lock a single time
+	if (!activatingBodies.empty()) {
+		bodyInterface.ActivateBodies(activatingBodies.data(), (int)activatingBodies.size());
+	}
+	commands.clear();
+
+	if (applyingSpawns.empty()) {
+		spawnedBodies.clear();
+		return;
+	}
+	// Spawns happen during play, so they must not pay for rebuilding the entire broad phase
+	spawnedBodies = CreateBodies(applyingSpawns, false);
+	applyingSpawns.clear();
+}
+
+void engine::physics::SubmitCommands(CommandBuffer& buffer) {
+	GetCurrentManager()->SubmitCommands(buffer);
+}
@@ -0,0 +1,190 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <engine/physics/manager.hpp>
+#include <engine/fs/fs.hpp>
+#include <engine/log/log.hpp>
+
+#include <Jolt/Physics/Collision/Shape/MeshShape.h>
+#include <Jolt/Physics/Collision/Shape/HeightFieldShape.h>
+#include <Jolt/Physics/Collision/Shape/StaticCompoundShape.h>
+
+// Every cooked file starts with this value, followed by the version and the type of the shape. Jolt's binary layout is
+// not versioned, so the version must be increased whenever an update to Jolt changes how shapes are written.
+const std::uint32_t cookedShapeMagic = 0x4B4F4F43; // "COOK"
+const std::uint32_t cookedShapeVersion = 1;
+
+bool engine::physics::CookMesh(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, std::span<const glm::vec3> vertices, std::span<const std::uint32_t> indices) {
+	return GetCurrentManager()->CookMesh(fileSystem, path, vertices, indices);
+}
+
+bool engine::physics::CookHeightField(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, std::span<const float> heights, std::uint32_t sampleCount, glm::vec3 offset, glm::vec3 scale) {
+	return GetCurrentManager()->CookHeightField(fileSystem, path, heights, sampleCount, offset, scale);
+}
+
+bool engine::physics::CookCompound(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, std::span<const CompoundChild> children, Mass mass) {
+	return GetCurrentManager()->CookCompound(fileSystem, path, children, mass);
+}
+
+std::unique_ptr<engine::physics::Body> engine::physics::CreateMesh(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, const BodyCreationProperties properties) {
+	return GetCurrentManager()->CreateMesh(fileSystem, path, properties);
+}
+
+std::unique_ptr<engine::physics::Body> engine::physics::CreateHeightField(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, const BodyCreationProperties properties) {
+	return GetCurrentManager()->CreateHeightField(fileSystem, path, properties);
+}
+
+std::unique_ptr<engine::physics::Body> engine::physics::CreateCompound(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, const BodyCreationProperties properties) {
+	return GetCurrentManager()->CreateCompound(fileSystem, path, properties);
+}
+
+bool engine::physics::Manager::CookMesh(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, std::span<const glm::vec3> vertices, std::span<const std::uint32_t> indices) {
+	if (indices.empty() || indices.size() % 3 != 0) {
+		engine::log::Error("Mesh indices must form whole triangles");
+		return false;
+	}
+	JPH::VertexList vertexList;
+	vertexList.reserve(vertices.size());
+	for (glm::vec3 vertex: vertices) {
+		vertexList.emplace_back(vertex.x, vertex.y, vertex.z);
+	}
+	JPH::IndexedTriangleList triangles;
+	triangles.reserve(indices.size() / 3);
+	for (size_t i = 0; i < indices.size(); i += 3) {
+		if (indices[i] >= vertices.size() || indices[i + 1] >= vertices.size() || indices[i + 2] >= vertices.size()) {
+			engine::log::Error("Mesh index is outside of the vertex list");
+			return false;
+		}
+		triangles.emplace_back(indices[i], indices[i + 1], indices[i + 2]);
+	}
+	// Building the mesh's bounding volume hierarchy is the expensive part, which is why meshes are cooked
+	JPH::MeshShapeSettings settings(std::move(vertexList), std::move(triangles));
+	JPH::ShapeSettings::ShapeResult result = settings.Create();
+	if (result.HasError()) {
+		engine::log::Error("Error creating MeshShape: %s", result.GetError().c_str());
+		return false;
+	}
+	return saveCookedShape(fileSystem, path, Shape::Mesh, result.Get());
+}
+
+bool engine::physics::Manager::CookHeightField(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, std::span<const float> heights, std::uint32_t sampleCount, glm::vec3 offset, glm::vec3 scale) {
+	if (heights.size() != (size_t)sampleCount * sampleCount) {
+		engine::log::Error("Height field requires %u heights, but %zu were given", sampleCount * sampleCount, heights.size());
+		return false;
+	}
+	JPH::HeightFieldShapeSettings settings(heights.data(), toJPH(offset), toJPH(scale), sampleCount);
+	JPH::ShapeSettings::ShapeResult result = settings.Create();
+	if (result.HasError()) {
+		engine::log::Error("Error creating HeightFieldShape: %s", result.GetError().c_str());
+		return false;
+	}
+	return saveCookedShape(fileSystem, path, Shape::HeightField, result.Get());
+}
+
+bool engine::physics::Manager::CookCompound(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, std::span<const CompoundChild> children, Mass mass) {
+	if (children.empty()) {
+		engine::log::Error("Compound requires at least one child");
+		return false;
+	}
+	JPH::StaticCompoundShapeSettings settings;
+	for (const CompoundChild& child: children) {
+		JPH::ShapeRefC shape = createShape(child.Shape, mass);
+		if (!shape) {
+			return false;
+		}
+		settings.AddShape(toJPH(child.Position), toJPH(child.Rotation), shape);
+	}
+	JPH::ShapeSettings::ShapeResult result = settings.Create();
+	if (result.HasError()) {
+		engine::log::Error("Error creating StaticCompoundShape: %s", result.GetError().c_str());
+		return false;
+	}
+	return saveCookedShape(fileSystem, path, Shape::Compound, result.Get());
+}
+
+std::unique_ptr<engine::physics::Body> engine::physics::Manager::CreateMesh(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, const BodyCreationProperties properties) {
+	return createCookedBody(fileSystem, path, Shape::Mesh, properties);
+}
+
+std::unique_ptr<engine::physics::Body> engine::physics::Manager::CreateHeightField(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, const BodyCreationProperties properties) {
+	return createCookedBody(fileSystem, path, Shape::HeightField, properties);
+}
+
+std::unique_ptr<engine::physics::Body> engine::physics::Manager::CreateCompound(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, const BodyCreationProperties properties) {
+	return createCookedBody(fileSystem, path, Shape::Compound, properties);
+}
+
+std::unique_ptr<engine::physics::Body> engine::physics::Manager::createCookedBody(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, Shape type, const BodyCreationProperties properties) {
+	// Jolt does not calculate mass properties for meshes and height fields, as they have no volume
+	if (type != Shape::Compound && properties.MotionType == MotionType::Dynamic) {
+		engine::log::Error("Mesh and height field bodies cannot be dynamic");
+		return nullptr;
+	}
+	JPH::ShapeRefC shape = loadCookedShape(fileSystem, path, type);
+	if (!shape) {
+		return nullptr;
+	}
+	return CreateBody(shape, properties);
+}
+
+bool engine::physics::Manager::saveCookedShape(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, Shape type, const JPH::Shape* shape) {
+	std::vector<std::uint8_t> data;
+	ByteStateRecorder recorder(data);
+	recorder.Write(cookedShapeMagic);
+	recorder.Write(cookedShapeVersion);
+	recorder.Write(type);
+	JPH::Shape::ShapeToIDMap shapeMap;
+	JPH::Shape::MaterialToIDMap materialMap;
+	shape->SaveWithChildren(recorder, shapeMap, materialMap);
+	if (!fileSystem.WriteFile(path, data.data(), data.size())) {
+		engine::log::Error("Unable to write the cooked shape to %s", path.string().c_str());
+		return false;
+	}
+	return true;
+}
+
+JPH::ShapeRefC engine::physics::Manager::loadCookedShape(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, Shape type) {
+	std::string key = path.generic_string();
+	auto cached = cookedShapeCache.find(key);
+	if (cached != cookedShapeCache.end()) {
+		if (cached->second.Type != type) {
+			engine::log::Error("Cooked shape %s holds a different type of shape", key.c_str());
+			return nullptr;
+		}
+		return cached->second.Collider;
+	}
+
+	std::unique_ptr<engine::fs::IBlob> blob = fileSystem.ReadFile(path);
+	if (!blob || engine::fs::IBlob::IsEmpty(*blob)) {
+		engine::log::Error("Unable to read the cooked shape %s", key.c_str());
+		return nullptr;
+	}
+	ByteStateRecorder recorder(std::span<const std::uint8_t>(static_cast<const std::uint8_t*>(blob->Data()), blob->Size()));
+	std::uint32_t magic = 0;
+	std::uint32_t version = 0;
+	Shape cookedType = Shape::Box;
+	recorder.Read(magic);
+	recorder.Read(version);
+	recorder.Read(cookedType);
+	if (recorder.IsFailed() || magic != cookedShapeMagic || version != cookedShapeVersion) {
+		engine::log::Error("%s is not a cooked shape, or it was cooked by a different version of the engine", key.c_str());
+		return nullptr;
+	}
+	if (cookedType != type) {
+		engine::log::Error("Cooked shape %s holds a different type of shape", key.c_str());
+		return nullptr;
+	}
+	JPH::Shape::IDToShapeMap shapeMap;
+	JPH::Shape::IDToMaterialMap materialMap;
+	JPH::Shape::ShapeResult result = JPH::Shape::sRestoreWithChildren(recorder, shapeMap, materialMap);
+	if (result.HasError() || recorder.IsFailed()) {
+		engine::log::Error("Unable to load the cooked shape %s", key.c_str());
+		return nullptr;
+	}
+	JPH::ShapeRefC shape = result.Get();
+	cookedShapeCache.emplace(std::move(key), cookedShape{.Type = type, .Collider = shape});
+	return shape;
+}
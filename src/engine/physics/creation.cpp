@@ -14,96 +14,234 @@
 #include <Jolt/Physics/Collision/Shape/CylinderShape.h>
 
 std::unique_ptr<engine::physics::Body> engine::physics::CreateSphere(float radius, const BodyCreationProperties properties) {
-	return std::move(GlobalManager->CreateSphere(radius, properties));
+	return std::move(GetCurrentManager()->CreateSphere(radius, properties));
 }
 
 std::unique_ptr<engine::physics::Body> engine::physics::CreateBox(glm::vec3 shape, const BodyCreationProperties properties) {
-	return std::move(GlobalManager->CreateBox(shape, properties));
+	return std::move(GetCurrentManager()->CreateBox(shape, properties));
 }
 
 std::unique_ptr<engine::physics::Body> engine::physics::CreateCapsule(float height, float radius, const BodyCreationProperties properties) {
-	return std::move(GlobalManager->CreateCapsule(height, radius, properties));
+	return std::move(GetCurrentManager()->CreateCapsule(height, radius, properties));
 }
 
 std::unique_ptr<engine::physics::Body> engine::physics::CreateTaperedCapsule(float height, float topRadius, float bottomRadius, const BodyCreationProperties properties) {
-	return std::move(GlobalManager->CreateTaperedCapsule(height, topRadius, bottomRadius, properties));
+	return std::move(GetCurrentManager()->CreateTaperedCapsule(height, topRadius, bottomRadius, properties));
 }
 
 std::unique_ptr<engine::physics::Body> engine::physics::CreateCylinder(float height, float radius, const BodyCreationProperties properties) {
-	return std::move(GlobalManager->CreateCylinder(height, radius, properties));
+	return std::move(GetCurrentManager()->CreateCylinder(height, radius, properties));
+}
+
+std::vector<engine::physics::Body> engine::physics::CreateBodies(std::span<const BatchBodyCreationProperties> properties, bool optimizeBroadPhase) {
+	return GetCurrentManager()->CreateBodies(properties, optimizeBroadPhase);
+}
+
+void engine::physics::DestroyBodies(std::span<const Body> bodies) {
+	GetCurrentManager()->DestroyBodies(bodies);
+}
+
+void engine::physics::ClearUnusedShapes() {
+	GetCurrentManager()->ClearUnusedShapes();
 }
 
 std::unique_ptr<engine::physics::Character> engine::physics::CreateCharacter(CharacterCreationProperties properties) {
-	return std::move(GlobalManager->CreateCharacter(properties));
+	return std::move(GetCurrentManager()->CreateCharacter(properties));
+}
+
+std::unique_ptr<engine::physics::VirtualCharacter> engine::physics::CreateVirtualCharacter(CharacterCreationProperties properties) {
+	return std::move(GetCurrentManager()->CreateVirtualCharacter(properties));
 }
 
 std::unique_ptr<engine::physics::Body> engine::physics::Manager::CreateSphere(float radius, const BodyCreationProperties properties) {
+	auto shape = createShape(ShapeProperties{.Type = Shape::Sphere, .Radius = radius}, properties.Mass);
+	if (!shape) {
+		return nullptr;
+	}
+	return std::move(CreateBody(shape, properties));
+}
+
+std::unique_ptr<engine::physics::Body> engine::physics::Manager::CreateBox(glm::vec3 boxShape, const BodyCreationProperties properties) {
+	auto shape = createShape(ShapeProperties{.Type = Shape::Box, .Size = boxShape}, properties.Mass);
+	if (!shape) {
+		return nullptr;
+	}
+	return std::move(CreateBody(shape, properties));
+}
+
+std::unique_ptr<engine::physics::Body> engine::physics::Manager::CreateCapsule(float height, float radius, const BodyCreationProperties properties) {
+	auto shape = createShape(ShapeProperties{.Type = Shape::Capsule, .Radius = radius, .Height = height}, properties.Mass);
+	if (!shape) {
+		return nullptr;
+	}
+	return std::move(CreateBody(shape, properties));
+}
+
+std::unique_ptr<engine::physics::Body> engine::physics::Manager::CreateTaperedCapsule(float height, float topRadius, float bottomRadius, const BodyCreationProperties properties) {
+	auto shape = createShape(ShapeProperties{.Type = Shape::TaperedCapsule, .Radius = topRadius, .BottomRadius = bottomRadius, .Height = height}, properties.Mass);
+	if (!shape) {
+		return nullptr;
+	}
+	return std::move(CreateBody(shape, properties));
+}
+
+std::unique_ptr<engine::physics::Body> engine::physics::Manager::CreateCylinder(float height, float radius, const BodyCreationProperties properties) {
+	auto shape = createShape(ShapeProperties{.Type = Shape::Cylinder, .Radius = radius, .Height = height}, properties.Mass);
+	if (!shape) {
+		return nullptr;
+	}
+	return std::move(CreateBody(shape, properties));
+}
+
+JPH::ShapeRefC engine::physics::Manager::createShape(const ShapeProperties& shape, Mass mass) {
+	// Only the dimensions that the shape uses are part of the key, so unused dimensions do not split the cache
+	shapeKey key{.Type = shape.Type};
+	switch (shape.Type) {
+		case Shape::Sphere:
+			key.Dimensions[0] = shape.Radius;
+			break;
+		case Shape::Box:
+			key.Dimensions[0] = shape.Size.x;
+			key.Dimensions[1] = shape.Size.y;
+			key.Dimensions[2] = shape.Size.z;
+			break;
+		case Shape::Capsule:
+		case Shape::Cylinder:
+			key.Dimensions[0] = shape.Radius;
+			key.Dimensions[1] = shape.Height;
+			break;
+		case Shape::TaperedCapsule:
+			key.Dimensions[0] = shape.Radius;
+			key.Dimensions[1] = shape.Height;
+			key.Dimensions[2] = shape.BottomRadius;
+			break;
+		default:
+			engine::log::Error("Unknown physics Shape encountered");
+			return nullptr;
+	}
+	if (mass.Density >= std::numeric_limits<float>::epsilon()) {
+		key.Density = mass.Density;
+	} else if (mass.Weight >= std::numeric_limits<float>::epsilon()) {
+		key.Weight = mass.Weight;
+	}
+
+	auto cachedShape = shapeCache.find(key);
+	if (cachedShape != shapeCache.end()) {
+		return cachedShape->second;
+	}
+	JPH::ShapeRefC newShape;
+	switch (shape.Type) {
+		case Shape::Sphere:
+			newShape = createSphereShape(shape.Radius, mass);
+			break;
+		case Shape::Box:
+			newShape = createBoxShape(shape.Size, mass);
+			break;
+		case Shape::Capsule:
+			newShape = createCapsuleShape(shape.Height, shape.Radius, mass);
+			break;
+		case Shape::TaperedCapsule:
+			newShape = createTaperedCapsuleShape(shape.Height, shape.Radius, shape.BottomRadius, mass);
+			break;
+		case Shape::Cylinder:
+			newShape = createCylinderShape(shape.Height, shape.Radius, mass);
+			break;
+		default:
+			break;
+	}
+	if (newShape != nullptr) {
+		shapeCache.emplace(key, newShape);
+	}
+	return newShape;
+}
+
+void engine::physics::Manager::ClearUnusedShapes() {
+	// A reference count of one means that only the cache is holding onto the shape
+	std::erase_if(shapeCache, [](const auto& entry) {
+		return entry.second->GetRefCount() == 1;
+	});
+	std::erase_if(cookedShapeCache, [](const auto& entry) {
+		return entry.second.Collider->GetRefCount() == 1;
+	});
+}
+
+std::size_t engine::physics::Manager::shapeKeyHash::operator()(const shapeKey& key) const {
+	std::size_t hash = std::hash<std::uint8_t>()((std::uint8_t)key.Type);
+	auto combine = [&hash](float value) {
+		hash ^= std::hash<float>()(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+	};
+	for (float dimension: key.Dimensions) {
+		combine(dimension);
+	}
+	combine(key.Density);
+	combine(key.Weight);
+	return hash;
+}
+
+JPH::ShapeRefC engine::physics::Manager::createSphereShape(float radius, Mass mass) {
 	auto shapeSettings = JPH::SphereShapeSettings(radius);
-	if (properties.Mass.Density >= std::numeric_limits<float>::epsilon()) {
-		shapeSettings.SetDensity(properties.Mass.Density);
-	} else if (properties.Mass.Weight >= std::numeric_limits<float>::epsilon()) {
+	if (mass.Density >= std::numeric_limits<float>::epsilon()) {
+		shapeSettings.SetDensity(mass.Density);
+	} else if (mass.Weight >= std::numeric_limits<float>::epsilon()) {
 		// Convert the mass to a uniform density, adapted from shape->GetMassProperties()
-		shapeSettings.SetDensity(properties.Mass.Weight / ((4.0f / 3.0f * JPH::JPH_PI) * radius * radius * radius));
+		shapeSettings.SetDensity(mass.Weight / ((4.0f / 3.0f * JPH::JPH_PI) * radius * radius * radius));
 	}
 	JPH::ShapeSettings::ShapeResult result{};
-	auto shape = new JPH::SphereShape(shapeSettings, result); // Pointer memory is handled by Jolt
+	JPH::ShapeRefC shape = new JPH::SphereShape(shapeSettings, result); // Pointer memory is handled by Jolt
 	if (result.HasError()) {
 		engine::log::Error("Error creating SphereShape: %s", result.GetError().c_str());
-		delete (shape);
 		return nullptr;
 	}
-	return std::move(CreateBody(shape, properties));
+	return shape;
 }
 
-std::unique_ptr<engine::physics::Body> engine::physics::Manager::CreateBox(glm::vec3 boxShape, const BodyCreationProperties properties) {
+JPH::ShapeRefC engine::physics::Manager::createBoxShape(glm::vec3 boxShape, Mass mass) {
 	// The convex radius must be smaller than the smallest side
 	auto halfExtents = toJPH(boxShape * 0.5f);
 	auto minSide = halfExtents.ReduceMin();
 	auto shapeSettings = JPH::BoxShapeSettings(halfExtents,
 											   (minSide <= JPH::cDefaultConvexRadius) ? std::nextafter(minSide, -1.0f) : JPH::cDefaultConvexRadius);
-	if (properties.Mass.Density >= std::numeric_limits<float>::epsilon()) {
-		shapeSettings.SetDensity(properties.Mass.Density);
-	} else if (properties.Mass.Weight >= std::numeric_limits<float>::epsilon()) {
+	if (mass.Density >= std::numeric_limits<float>::epsilon()) {
+		shapeSettings.SetDensity(mass.Density);
+	} else if (mass.Weight >= std::numeric_limits<float>::epsilon()) {
 		// Convert the mass to a uniform density, adapted from shape->GetMassProperties()
-		shapeSettings.SetDensity(properties.Mass.Weight / (boxShape.x * boxShape.y * boxShape.z));
+		shapeSettings.SetDensity(mass.Weight / (boxShape.x * boxShape.y * boxShape.z));
 	}
 	JPH::ShapeSettings::ShapeResult result{};
-	auto shape = new JPH::BoxShape(shapeSettings, result); // Pointer memory is handled by Jolt
+	JPH::ShapeRefC shape = new JPH::BoxShape(shapeSettings, result); // Pointer memory is handled by Jolt
 	if (result.HasError()) {
 		engine::log::Error("Error creating BoxShape: %s", result.GetError().c_str());
-		delete (shape);
 		return nullptr;
 	}
-	return std::move(CreateBody(shape, properties));
+	return shape;
 }
 
-std::unique_ptr<engine::physics::Body> engine::physics::Manager::CreateCapsule(float height, float radius, const BodyCreationProperties properties) {
+JPH::ShapeRefC engine::physics::Manager::createCapsuleShape(float height, float radius, Mass mass) {
 	auto shapeSettings = JPH::CapsuleShapeSettings(height / 2.0f, radius);
-	if (properties.Mass.Density >= std::numeric_limits<float>::epsilon()) {
-		shapeSettings.SetDensity(properties.Mass.Density);
-	} else if (properties.Mass.Weight >= std::numeric_limits<float>::epsilon()) {
+	if (mass.Density >= std::numeric_limits<float>::epsilon()) {
+		shapeSettings.SetDensity(mass.Density);
+	} else if (mass.Weight >= std::numeric_limits<float>::epsilon()) {
 		// Convert the mass to a uniform density, adapted from shape->GetMassProperties()
 		float radiusSq = radius * radius;
 		float cylinder_mass = JPH::JPH_PI * height * radiusSq;
 		float hemisphere_mass = (2.0f * JPH::JPH_PI / 3.0f) * 2.0f * radiusSq * radius;
-		shapeSettings.SetDensity(properties.Mass.Weight / (cylinder_mass + hemisphere_mass));
+		shapeSettings.SetDensity(mass.Weight / (cylinder_mass + hemisphere_mass));
 	}
 	JPH::ShapeSettings::ShapeResult result{};
-	auto shape = new JPH::CapsuleShape(shapeSettings, result); // Pointer memory is handled by Jolt
+	JPH::ShapeRefC shape = new JPH::CapsuleShape(shapeSettings, result); // Pointer memory is handled by Jolt
 	if (result.HasError()) {
 		engine::log::Error("Error creating CapsuleShape: %s", result.GetError().c_str());
-		delete (shape);
 		return nullptr;
 	}
-	return std::move(CreateBody(shape, properties));
+	return shape;
 }
 
-std::unique_ptr<engine::physics::Body> engine::physics::Manager::CreateTaperedCapsule(float height, float topRadius, float bottomRadius, const BodyCreationProperties properties) {
+JPH::ShapeRefC engine::physics::Manager::createTaperedCapsuleShape(float height, float topRadius, float bottomRadius, Mass mass) {
 	float halfHeight = height / 2.0f;
 	auto shapeSettings = JPH::TaperedCapsuleShapeSettings(halfHeight, topRadius, bottomRadius);
-	if (properties.Mass.Density >= std::numeric_limits<float>::epsilon()) {
-		shapeSettings.SetDensity(properties.Mass.Density);
-	} else if (properties.Mass.Weight >= std::numeric_limits<float>::epsilon()) {
+	if (mass.Density >= std::numeric_limits<float>::epsilon()) {
+		shapeSettings.SetDensity(mass.Density);
+	} else if (mass.Weight >= std::numeric_limits<float>::epsilon()) {
 		// Convert the mass to a uniform density, adapted from shape->GetMassProperties()
 		float mTopCenter = halfHeight + 0.5f * (shapeSettings.mBottomRadius - shapeSettings.mTopRadius);
 		float mBottomCenter = -halfHeight + 0.5f * (shapeSettings.mBottomRadius - shapeSettings.mTopRadius);
@@ -111,36 +249,33 @@ std::unique_ptr<engine::physics::Body> engine::physics::Manager::CreateTaperedCa
 		auto box = JPH::AABox(JPH::Vec3(-avgRadius, mBottomCenter - shapeSettings.mBottomRadius, -avgRadius),
 							  JPH::Vec3(avgRadius, mTopCenter + shapeSettings.mTopRadius, avgRadius));
 		auto boxSize = box.GetSize();
-		shapeSettings.SetDensity(properties.Mass.Weight / (boxSize.GetX() * boxSize.GetY() * boxSize.GetZ()));
+		shapeSettings.SetDensity(mass.Weight / (boxSize.GetX() * boxSize.GetY() * boxSize.GetZ()));
 	}
 	JPH::ShapeSettings::ShapeResult result{};
-	auto shape = new JPH::TaperedCapsuleShape(shapeSettings, result); // Pointer memory is handled by Jolt
+	JPH::ShapeRefC shape = new JPH::TaperedCapsuleShape(shapeSettings, result); // Pointer memory is handled by Jolt
 	if (result.HasError()) {
 		engine::log::Error("Error creating TaperedCapsuleShape: %s", result.GetError().c_str());
-		delete (shape);
 		return nullptr;
 	}
-	return std::move(CreateBody(shape, properties));
+	return shape;
 }
 
-std::unique_ptr<engine::physics::Body> engine::physics::Manager::CreateCylinder(float height, float radius, const BodyCreationProperties properties) {
+JPH::ShapeRefC engine::physics::Manager::createCylinderShape(float height, float radius, Mass mass) {
 	auto shapeSettings = JPH::CylinderShapeSettings(height / 2.0f, radius);
-	if (properties.Mass.Density >= std::numeric_limits<float>::epsilon()) {
-		shapeSettings.SetDensity(properties.Mass.Density);
-	} else if (properties.Mass.Weight >= std::numeric_limits<float>::epsilon()) {
+	if (mass.Density >= std::numeric_limits<float>::epsilon()) {
+		shapeSettings.SetDensity(mass.Density);
+	} else if (mass.Weight >= std::numeric_limits<float>::epsilon()) {
 		// Convert the mass to a uniform density, adapted from shape->GetMassProperties()
-		shapeSettings.SetDensity(properties.Mass.Weight / (JPH::JPH_PI * height * radius * radius));
+		shapeSettings.SetDensity(mass.Weight / (JPH::JPH_PI * height * radius * radius));
 	}
 	JPH::ShapeSettings::ShapeResult result{};
-	auto shape = new JPH::CylinderShape(shapeSettings, result); // Pointer memory is handled by Jolt
+	JPH::ShapeRefC shape = new JPH::CylinderShape(shapeSettings, result); // Pointer memory is handled by Jolt
 	if (result.HasError()) {
 		engine::log::Error("Error creating CylinderShape: %s", result.GetError().c_str());
-		delete (shape);
 		return nullptr;
 	}
-	return std::move(CreateBody(shape, properties));
+	return shape;
 }
 
 
 //TODO: create joints
-//TODO: create height field shape
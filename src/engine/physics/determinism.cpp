@@ -0,0 +1,106 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <engine/physics/manager.hpp>
+#include <engine/log/log.hpp>
+#include <algorithm>
+#include <cstring>
+
+#include <Jolt/Physics/Body/BodyLock.h>
+
+const std::uint64_t fnvOffsetBasis = 14695981039346656037ull;
+const std::uint64_t fnvPrime = 1099511628211ull;
+
+// Hashes the exact bits of each value with FNV-1a, so that any difference in the last bit of a float changes the hash.
+static void hashValue(std::uint64_t& hash, const void* data, size_t size) {
+	auto bytes = static_cast<const std::uint8_t*>(data);
+	for (size_t i = 0; i < size; i++) {
+		hash ^= bytes[i];
+		hash *= fnvPrime;
+	}
+}
+
+static void hashVector(std::uint64_t& hash, JPH::Vec3 vec) {
+	float components[3] = {vec.GetX(), vec.GetY(), vec.GetZ()};
+	hashValue(hash, components, sizeof(components));
+}
+
+std::span<const std::uint64_t> engine::physics::Manager::GetStepHashes() {
+	if (asynchronous) {
+		return publishedStepHashes;
+	}
+	return stepHashes;
+}
+
+std::uint64_t engine::physics::Manager::HashState() {
+	physicsSystem->GetBodies(hashedBodies);
+	// Body IDs are not guaranteed to be returned in any particular order, so they're sorted to make the hash stable
+	std::sort(hashedBodies.begin(), hashedBodies.end());
+	const JPH::BodyLockInterfaceNoLock& lockInterface = physicsSystem->GetBodyLockInterfaceNoLock();
+	std::uint64_t hash = fnvOffsetBasis;
+	for (JPH::BodyID bodyID : hashedBodies) {
+		const JPH::Body* body = lockInterface.TryGetBody(bodyID);
+		if (!body) {
+			continue;
+		}
+		std::uint32_t id = bodyID.GetIndexAndSequenceNumber();
+		hashValue(hash, &id, sizeof(id));
+		hashVector(hash, body->GetPosition());
+		JPH::Quat rotation = body->GetRotation();
+		float rotationComponents[4] = {rotation.GetX(), rotation.GetY(), rotation.GetZ(), rotation.GetW()};
+		hashValue(hash, rotationComponents, sizeof(rotationComponents));
+		hashVector(hash, body->GetLinearVelocity());
+		hashVector(hash, body->GetAngularVelocity());
+	}
+	return hash;
+}
+
+engine::physics::DeterminismResult engine::physics::Manager::VerifyDeterminism(std::uint32_t steps, std::uint32_t runs) {
+	DeterminismResult result;
+	PhysicsState initialState;
+	SaveState(initialState);
+	std::vector<std::uint64_t> expectedHashes(steps);
+	std::vector<std::uint64_t> actualHashes(steps);
+	for (std::uint32_t run = 0; run < runs && result.Deterministic; run++) {
+		if (run > 0 && !RestoreState(initialState)) {
+			engine::log::Error("Unable to verify determinism, as the initial state could not be restored");
+			result.Deterministic = false;
+			break;
+		}
+		std::vector<std::uint64_t>& hashes = (run == 0) ? expectedHashes : actualHashes;
+		for (std::uint32_t i = 0; i < steps; i++) {
+			physicsSystem->Update(maxDeltaTimeStepf, 1, 1, tempAllocator.get(), jobSystem.get());
+			hashes[i] = HashState();
+		}
+		if (run == 0) {
+			continue;
+		}
+		auto mismatch = std::mismatch(expectedHashes.begin(), expectedHashes.end(), actualHashes.begin());
+		if (mismatch.first != expectedHashes.end()) {
+			result.Deterministic = false;
+			result.FirstDivergentStep = (std::uint32_t)(mismatch.first - expectedHashes.begin());
+			result.ExpectedHash = *mismatch.first;
+			result.ActualHash = *mismatch.second;
+		}
+	}
+	RestoreState(initialState);
+	// The verification steps are not part of the simulation, so their contacts must not count towards the next step
+	contactListener->TakeContactCount();
+	contactListener->ClearSensorChanges();
+	return result;
+}
+
+std::span<const std::uint64_t> engine::physics::GetStepHashes() {
+	return GetCurrentManager()->GetStepHashes();
+}
+
+std::uint64_t engine::physics::HashState() {
+	return GetCurrentManager()->HashState();
+}
+
+engine::physics::DeterminismResult engine::physics::VerifyDeterminism(std::uint32_t steps, std::uint32_t runs) {
+	return GetCurrentManager()->VerifyDeterminism(steps, runs);
+}
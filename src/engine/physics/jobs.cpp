@@ -0,0 +1,55 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <engine/physics/manager.hpp>
+#include <chrono>
+#include <thread>
+
+engine::physics::JobSystemImpl::JobSystemImpl(JPH::uint maxJobs, JPH::uint maxBarriers) : JPH::JobSystemWithBarrier(maxBarriers) {
+	jobs.Init(maxJobs, maxJobs);
+}
+
+int engine::physics::JobSystemImpl::GetMaxConcurrency() const {
+	return (int)engine::jobs::GetWorkerCount() + 1;
+}
+
+JPH::JobSystem::JobHandle engine::physics::JobSystemImpl::CreateJob(const char* inName, JPH::ColorArg inColor, const JobFunction& inJobFunction, JPH::uint32 inNumDependencies) {
+	JPH::uint32 index;
+	while (true) {
+		index = jobs.ConstructObject(inName, inColor, this, inJobFunction, inNumDependencies);
+		if (index != decltype(jobs)::cInvalidObjectIndex) {
+			break;
+		}
+		// All jobs are in use, so we wait for some to finish
+		JPH_ASSERT(false, "No jobs available!");
+		std::this_thread::sleep_for(std::chrono::microseconds(100));
+	}
+	Job* job = &jobs.Get(index);
+	JobHandle handle(job);
+	if (inNumDependencies == 0) {
+		QueueJob(job);
+	}
+	return handle;
+}
+
+void engine::physics::JobSystemImpl::QueueJob(Job* inJob) {
+	// The reference is released once the job has run, which frees the job if nothing else holds a handle to it
+	inJob->AddRef();
+	engine::jobs::Submit([inJob]() {
+		inJob->Execute();
+		inJob->Release();
+	}, engine::jobs::Priority::High);
+}
+
+void engine::physics::JobSystemImpl::QueueJobs(Job** inJobs, JPH::uint inNumJobs) {
+	for (JPH::uint i = 0; i < inNumJobs; i++) {
+		QueueJob(inJobs[i]);
+	}
+}
+
+void engine::physics::JobSystemImpl::FreeJob(Job* inJob) {
+	jobs.DestructObject(inJob);
+}
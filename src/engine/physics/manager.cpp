@@ -6,6 +6,10 @@
 
 #include <engine/physics/manager.hpp>
 #include <engine/log/log.hpp>
+#include <engine/profile/profile.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <cstdarg>
 #include <thread>
 
@@ -19,17 +23,12 @@ namespace engine::physics {
 	Manager* GlobalManager = nullptr;
 }
 
-// Size of the temp allocator used for temporary allocations during the physics update.
-const int allocatorSize = 10 * 1024 * 1024;
-// This is the max amount of rigid bodies that can be added to the physics system. Adding more will produce an error.
-const unsigned int maxPhysicsBodies = 65536;
-// The number of mutexes to allocate to protect rigid bodies from concurrent access. 0 represents the default settings.
-const unsigned int numberOfBodyMutexes = 0;
-// The max amount of body pairs that can be queued at any time for the broad phase.
-const unsigned int maxBodyPairs = 65536;
-// The maximum size of the contact constraint buffer. If more contacts are detected than this, then the additional ones
-// will be ignored (causing clipping, falling through the world, etc.)
-const unsigned int maxContactConstraints = 10240;
+// The world that the free functions operate on for the current thread, when it isn't the global world
+static thread_local engine::physics::Manager* currentManager = nullptr;
+// Jolt's factory and type registrations are shared by every world, so they only exist while at least one world does
+static std::mutex joltMutex;
+static std::uint32_t joltReferences = 0;
+
 // Maximum amount of physics jobs to allow.
 const int maxPhysicsJobs = JPH::cMaxPhysicsJobs;
 // Maximum amount of physics barriers to allow.
@@ -50,141 +49,481 @@ static bool AssertionFailed(const char* expr, const char* message, const char* f
 };
 #endif // JPH_ENABLE_ASSERTS
 
+engine::physics::ObjectLayerPairFilterImpl::ObjectLayerPairFilterImpl(const LayerConfiguration& configuration) {
+	for (std::uint32_t i = 0; i < configuration.LayerCount; i++) {
+		for (std::uint32_t j = 0; j < configuration.LayerCount; j++) {
+			if ((configuration.CollisionMasks[i] & (LayerMask(1) << j)) != 0) {
+				collisionMasks[i] |= LayerMask(1) << j;
+				collisionMasks[j] |= LayerMask(1) << i;
+			}
+		}
+	}
+}
+
 // Determines if two object layers can collide.
 bool engine::physics::ObjectLayerPairFilterImpl::ShouldCollide(JPH::ObjectLayer inObject1, JPH::ObjectLayer inObject2) const {
-	switch (inObject1) {
-		case engine::physics::Layers::NON_MOVING:
-			return inObject2 == engine::physics::Layers::MOVING; // Non-moving only collides with moving
-		case engine::physics::Layers::MOVING:
-			return true; // Moving collides with everything
-		default:
-			assert(false);
-			return false;
-	}
+	assert(inObject1 < MaxLayers && inObject2 < MaxLayers);
+	return (collisionMasks[inObject1] & (LayerMask(1) << inObject2)) != 0;
 };
 
-engine::physics::BroadPhaseLayerImpl::BroadPhaseLayerImpl() = default;
+engine::physics::BroadPhaseLayerImpl::BroadPhaseLayerImpl(const LayerConfiguration& configuration)
+	: layerCount(configuration.LayerCount), broadPhaseLayerCount(configuration.BroadPhaseLayerCount) {
+	for (std::uint32_t i = 0; i < MaxLayers; i++) {
+		objToBP[i] = JPH::BroadPhaseLayer(configuration.BroadPhaseLayers[i]);
+#if defined(JPH_EXTERNAL_PROFILE) || defined(JPH_PROFILE_ENABLED)
+		broadPhaseLayerNames[i] = "BroadPhaseLayer" + std::to_string(i);
+#endif // JPH_EXTERNAL_PROFILE || JPH_PROFILE_ENABLED
+	}
+}
 
 JPH::uint engine::physics::BroadPhaseLayerImpl::GetNumBroadPhaseLayers() const {
-	return BroadPhaseLayers::NUM_LAYERS;
+	return broadPhaseLayerCount;
 }
 
 JPH::BroadPhaseLayer engine::physics::BroadPhaseLayerImpl::GetBroadPhaseLayer(JPH::ObjectLayer layer) const {
-	assert(layer < Layers::NUM_LAYERS);
+	assert(layer < layerCount);
 	return objToBP[layer];
 }
 
 #if defined(JPH_EXTERNAL_PROFILE) || defined(JPH_PROFILE_ENABLED)
 const char* engine::physics::BroadPhaseLayerImpl::GetBroadPhaseLayerName(JPH::BroadPhaseLayer layer) const {
-	switch ((JPH::BroadPhaseLayer::Type)layer) {
-		case (JPH::BroadPhaseLayer::Type)BroadPhaseLayers::NONMOVING:
-			return "NONMOVING";
-		case (JPH::BroadPhaseLayer::Type)BroadPhaseLayers::MOVING:
-			return "MOVING";
-		default:
-			assert(false);
-			return "INVALID";
-	}
+	auto index = (JPH::BroadPhaseLayer::Type)layer;
+	assert(index < broadPhaseLayerCount);
+	return broadPhaseLayerNames[index].c_str();
 }
 #endif // JPH_EXTERNAL_PROFILE || JPH_PROFILE_ENABLED
 
+engine::physics::ObjectVsBroadPhaseLayerFilterImpl::ObjectVsBroadPhaseLayerFilterImpl(const LayerConfiguration& configuration) {
+	// An object layer needs to look into a broad phase layer if it collides with any object layer within it
+	ObjectLayerPairFilterImpl pairFilter(configuration);
+	for (std::uint32_t i = 0; i < configuration.LayerCount; i++) {
+		for (std::uint32_t j = 0; j < configuration.LayerCount; j++) {
+			if (pairFilter.ShouldCollide((JPH::ObjectLayer)i, (JPH::ObjectLayer)j)) {
+				broadPhaseMasks[i] |= LayerMask(1) << configuration.BroadPhaseLayers[j];
+			}
+		}
+	}
+}
+
 // Determines if two broadphase layers can collide.
 bool engine::physics::ObjectVsBroadPhaseLayerFilterImpl::ShouldCollide(JPH::ObjectLayer inLayer1, JPH::BroadPhaseLayer inLayer2) const {
-	switch (inLayer1) {
-		case engine::physics::Layers::NON_MOVING:
-			return inLayer2 == engine::physics::BroadPhaseLayers::MOVING;
-		case engine::physics::Layers::MOVING:
-			return true;
-		default:
-			assert(false);
+	assert(inLayer1 < MaxLayers);
+	return (broadPhaseMasks[inLayer1] & (LayerMask(1) << (JPH::BroadPhaseLayer::Type)inLayer2)) != 0;
+}
+
+// Registers Jolt's allocator, factory and types when the first world is created. Every world holds a reference until
+// it is destroyed.
+static void acquireJolt() {
+	std::lock_guard<std::mutex> lock(joltMutex);
+	if (joltReferences++ > 0) {
+		return;
+	}
+	JPH::RegisterDefaultAllocator();
+	JPH::Trace = DebugTraceCallback;
+	JPH_IF_ENABLE_ASSERTS(JPH::AssertFailed = AssertionFailed);
+	JPH::Factory::sInstance = new JPH::Factory();
+	JPH::RegisterTypes();
+}
+
+// Releases a world's reference, destroying the factory once the last world is gone.
+static void releaseJolt() {
+	std::lock_guard<std::mutex> lock(joltMutex);
+	if (--joltReferences > 0) {
+		return;
+	}
+	delete JPH::Factory::sInstance;
+	JPH::Factory::sInstance = nullptr;
+}
+
+// Returns whether the configuration can be used by the physics engine, logging the reason if it cannot.
+static bool validateLayerConfiguration(const engine::physics::LayerConfiguration& configuration) {
+	if (configuration.LayerCount < 2 || configuration.LayerCount > engine::physics::MaxLayers) {
+		engine::log::Error("Physics layer count must be between 2 and %u, found %u", engine::physics::MaxLayers, configuration.LayerCount);
+		return false;
+	}
+	if (configuration.BroadPhaseLayerCount < 1 || configuration.BroadPhaseLayerCount > engine::physics::MaxLayers) {
+		engine::log::Error("Physics broad phase layer count must be between 1 and %u, found %u", engine::physics::MaxLayers, configuration.BroadPhaseLayerCount);
+		return false;
+	}
+	for (std::uint32_t i = 0; i < configuration.LayerCount; i++) {
+		if (configuration.BroadPhaseLayers[i] >= configuration.BroadPhaseLayerCount) {
+			engine::log::Error("Physics layer %u uses broad phase layer %u, which does not exist", i, (std::uint32_t)configuration.BroadPhaseLayers[i]);
 			return false;
+		}
 	}
+	return true;
 }
 
+engine::physics::InternalContactListener::InternalContactListener(Manager* manager, std::uint32_t capacity) : manager(manager), events(capacity) {}
+
 JPH::ValidateResult engine::physics::InternalContactListener::OnContactValidate(const JPH::Body& inBody1, const JPH::Body& inBody2, JPH::RVec3Arg inBaseOffset, const JPH::CollideShapeResult& inCollisionResult) {
 	return JPH::ValidateResult::AcceptAllContactsForThisBodyPair;
 }
 
 void engine::physics::InternalContactListener::OnContactAdded(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold, JPH::ContactSettings& ioSettings) {
+	record(ContactEventType::Added, inBody1, inBody2, inManifold);
+	// Sensor contacts don't take a contact constraint, so they are not counted
+	if (!inBody1.IsSensor() && !inBody2.IsSensor()) {
+		contactCount.fetch_add(1, std::memory_order_relaxed);
+	} else {
+		// Jolt does not report contacts between two sensors, so only one of the bodies is a sensor
+		bool sensorIs1 = inBody1.IsSensor();
+		std::lock_guard<std::mutex> lock(sensorMutex);
+		sensorChanges.push_back(SensorChange{
+			.Type = ContactEventType::Added,
+			.SensorID = sensorIs1 ? inBody1.GetID().GetIndexAndSequenceNumber() : inBody2.GetID().GetIndexAndSequenceNumber(),
+			.OtherID = sensorIs1 ? inBody2.GetID().GetIndexAndSequenceNumber() : inBody1.GetID().GetIndexAndSequenceNumber(),
+		});
+	}
 }
 
 void engine::physics::InternalContactListener::OnContactPersisted(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold, JPH::ContactSettings& ioSettings) {
+	if (!inBody1.IsSensor() && !inBody2.IsSensor()) {
+		contactCount.fetch_add(1, std::memory_order_relaxed);
+	}
+	record(ContactEventType::Persisted, inBody1, inBody2, inManifold);
 }
 
 void engine::physics::InternalContactListener::OnContactRemoved(const JPH::SubShapeIDPair& inSubShapePair) {
-}
-
-// Modeled from Jolt/Physics/Collision/CollisionCollectorImpl.h::ClosestHitCollisionCollector
-template<class CollectorType>
-class FurthestHitCollisionCollector : public CollectorType {
-public:
-	void Reset() override {
-		CollectorType::Reset();
-		mHadHit = false;
+	// The removed bodies may already have been destroyed, so the sensor contacts are used to tell whether this was a
+	// sensor. They are only modified between steps, and a contact is never added and removed within the same step.
+	std::uint32_t id1 = inSubShapePair.GetBody1ID().GetIndexAndSequenceNumber();
+	std::uint32_t id2 = inSubShapePair.GetBody2ID().GetIndexAndSequenceNumber();
+	auto sensorContact = manager->sensorContacts.find(Manager::sensorPairKey(id1, id2));
+	if (sensorContact != manager->sensorContacts.end()) {
+		std::lock_guard<std::mutex> lock(sensorMutex);
+		sensorChanges.push_back(SensorChange{
+			.Type = ContactEventType::Removed,
+			.SensorID = sensorContact->second.SensorID,
+			.OtherID = sensorContact->second.OtherID,
+		});
 	}
-	void AddHit(const typename CollectorType::ResultType& inResult) override {
-		float early_out = inResult.GetEarlyOutFraction();
-		if (!mHadHit || early_out > mHit.GetEarlyOutFraction()) {
-			mHit = inResult;
-			mHadHit = true;
-		}
+	std::uint32_t index = cursor.fetch_add(1, std::memory_order_relaxed);
+	if (index >= events.size()) {
+		return;
 	}
-	inline bool HadHit() const {
-		return mHadHit;
+	// Bodies are not added or removed during a step, so they may be read without locking. Bodies that were removed
+	// before the step no longer exist, and have no user data.
+	const JPH::BodyLockInterfaceNoLock& lockInterface = manager->physicsSystem->GetBodyLockInterfaceNoLock();
+	const JPH::Body* body1 = lockInterface.TryGetBody(inSubShapePair.GetBody1ID());
+	const JPH::Body* body2 = lockInterface.TryGetBody(inSubShapePair.GetBody2ID());
+	events[index] = ContactEvent{
+		.Type = ContactEventType::Removed,
+		.BodyA = Body(inSubShapePair.GetBody1ID().GetIndexAndSequenceNumber(), manager, false),
+		.BodyB = Body(inSubShapePair.GetBody2ID().GetIndexAndSequenceNumber(), manager, false),
+		.UserDataA = body1 ? body1->GetUserData() : 0,
+		.UserDataB = body2 ? body2->GetUserData() : 0,
+	};
+}
+
+void engine::physics::InternalContactListener::record(ContactEventType type, const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold) {
+	std::uint32_t index = cursor.fetch_add(1, std::memory_order_relaxed);
+	if (index >= events.size()) {
+		return;
 	}
-	typename CollectorType::ResultType mHit;
+	JPH::Vec3 point = JPH::Vec3::sZero();
+	for (JPH::uint i = 0; i < inManifold.mRelativeContactPointsOn1.size(); i++) {
+		point += inManifold.mRelativeContactPointsOn1[i];
+	}
+	if (!inManifold.mRelativeContactPointsOn1.empty()) {
+		point /= (float)inManifold.mRelativeContactPointsOn1.size();
+	}
+	JPH::RVec3 worldPoint = inManifold.mBaseOffset + point;
+	JPH::Vec3 normal = inManifold.mWorldSpaceNormal;
+
+	// The impulse that stops the approach along the normal is the approach speed multiplied by the effective mass
+	float approachSpeed = (inBody1.GetPointVelocity(worldPoint) - inBody2.GetPointVelocity(worldPoint)).Dot(normal);
+	float inverseMass1 = inBody1.IsDynamic() ? inBody1.GetMotionProperties()->GetInverseMass() : 0.0f;
+	float inverseMass2 = inBody2.IsDynamic() ? inBody2.GetMotionProperties()->GetInverseMass() : 0.0f;
+	float inverseMassSum = inverseMass1 + inverseMass2;
+	float impulse = (approachSpeed > 0.0f && inverseMassSum > 0.0f) ? approachSpeed / inverseMassSum : 0.0f;
+
+	events[index] = ContactEvent{
+		.Type = type,
+		.BodyA = Body(inBody1.GetID().GetIndexAndSequenceNumber(), manager, false),
+		.BodyB = Body(inBody2.GetID().GetIndexAndSequenceNumber(), manager, false),
+		.UserDataA = inBody1.GetUserData(),
+		.UserDataB = inBody2.GetUserData(),
+		.Point = toGLM(worldPoint),
+		.Normal = toGLM(normal),
+		.Impulse = impulse,
+		.IsSensor = inBody1.IsSensor() || inBody2.IsSensor(),
+	};
+}
+
+void engine::physics::InternalContactListener::Reset() {
+	cursor.store(0, std::memory_order_relaxed);
+	eventCount = 0;
+}
+
+void engine::physics::InternalContactListener::Finalize() {
+	std::uint32_t recorded = cursor.load(std::memory_order_acquire);
+	if (recorded > peakEventCount) {
+		peakEventCount = recorded;
+	}
+	if (recorded > events.size()) {
+		engine::log::Debug("Contact event limit has been hit, dropped %u contact events", recorded - (std::uint32_t)events.size());
+		recorded = (std::uint32_t)events.size();
+	}
+	eventCount = recorded;
+	// Job threads record events in a nondeterministic order, so they're sorted to give a stable order to the reader
+	std::stable_sort(events.begin(), events.begin() + eventCount, [](const ContactEvent& lhs, const ContactEvent& rhs) {
+		if (lhs.BodyA.GetID() != rhs.BodyA.GetID()) {
+			return lhs.BodyA.GetID() < rhs.BodyA.GetID();
+		}
+		if (lhs.BodyB.GetID() != rhs.BodyB.GetID()) {
+			return lhs.BodyB.GetID() < rhs.BodyB.GetID();
+		}
+		return lhs.Type < rhs.Type;
+	});
+}
 
-private:
-	bool mHadHit = false;
-};
+std::span<const engine::physics::ContactEvent> engine::physics::InternalContactListener::GetEvents() const {
+	return {events.data(), eventCount};
+}
 
-engine::physics::Manager::Manager(engine::Application* application) : application(application) {
-	JPH::RegisterDefaultAllocator();
-	JPH::Trace = DebugTraceCallback;
-	JPH_IF_ENABLE_ASSERTS(JPH::AssertFailed = AssertionFailed);
-	JPH::Factory::sInstance = new JPH::Factory();
-	JPH::RegisterTypes();
+std::uint32_t engine::physics::InternalContactListener::TakeContactCount() {
+	return contactCount.exchange(0, std::memory_order_relaxed);
+}
+
+std::uint32_t engine::physics::InternalContactListener::GetPeakEventCount() const {
+	return peakEventCount;
+}
+
+void engine::physics::InternalContactListener::ResetPeakEventCount() {
+	peakEventCount = 0;
+}
 
-	tempAllocator = std::make_unique<JPH::TempAllocatorImpl>(allocatorSize);
-	int numOfThreads = (int)std::thread::hardware_concurrency() - 1;
-	if (numOfThreads < 0) {
-		numOfThreads = 0;
+std::span<const engine::physics::InternalContactListener::SensorChange> engine::physics::InternalContactListener::GetSensorChanges() const {
+	return sensorChanges;
+}
+
+void engine::physics::InternalContactListener::ClearSensorChanges() {
+	sensorChanges.clear();
+}
+
+engine::physics::Manager::Manager(engine::Application* application, const PhysicsOptions& options)
+		: application(application), stepMode(options.Deterministic ? StepMode::Accumulate : options.Stepping),
+		  maxSubsteps(std::max(options.MaxSubsteps, 1u)), maxContactConstraints(options.MaxContactConstraints),
+		  maxContactEvents(options.MaxContactEvents), deterministic(options.Deterministic), asynchronous(options.Asynchronous) {
+	LayerConfiguration layerConfiguration = options.LayerConfiguration;
+	if (!validateLayerConfiguration(layerConfiguration)) {
+		engine::log::Error("Falling back to the default physics layers");
+		layerConfiguration = LayerConfiguration{};
 	}
-	jobSystem = std::make_unique<JPH::JobSystemThreadPool>(maxPhysicsJobs, maxPhysicsBarriers, numOfThreads);
-	broadPhaseLayerImpl = std::make_unique<BroadPhaseLayerImpl>();
-	objectVsBroadPhaseLayerFilterImpl = std::make_unique<ObjectVsBroadPhaseLayerFilterImpl>();
-	objectLayerPairFilterImpl = std::make_unique<ObjectLayerPairFilterImpl>();
+	layerCount = layerConfiguration.LayerCount;
+
+	acquireJolt();
+	tempAllocator = std::make_unique<GrowingTempAllocator>(options.TempAllocatorSize, options.GrowTempAllocator);
+	jobSystem = std::make_unique<JobSystemImpl>(maxPhysicsJobs, maxPhysicsBarriers);
+	broadPhaseLayerImpl = std::make_unique<BroadPhaseLayerImpl>(layerConfiguration);
+	objectVsBroadPhaseLayerFilterImpl = std::make_unique<ObjectVsBroadPhaseLayerFilterImpl>(layerConfiguration);
+	objectLayerPairFilterImpl = std::make_unique<ObjectLayerPairFilterImpl>(layerConfiguration);
 	physicsSystem = std::make_unique<JPH::PhysicsSystem>();
-	physicsSystem->Init(maxPhysicsBodies,
-						numberOfBodyMutexes,
-						maxBodyPairs,
-						maxContactConstraints,
+	physicsSystem->Init(options.MaxBodies,
+						options.BodyMutexes,
+						options.MaxBodyPairs,
+						options.MaxContactConstraints,
 						*broadPhaseLayerImpl,
 						*objectVsBroadPhaseLayerFilterImpl,
 						*objectLayerPairFilterImpl);
-	JPH::BodyInterface& bodyInterface = physicsSystem->GetBodyInterface();
+	contactListener = std::make_unique<InternalContactListener>(this, options.MaxContactEvents);
+	physicsSystem->SetContactListener(contactListener.get());
+	if (deterministic) {
+		JPH::PhysicsSettings settings = physicsSystem->GetPhysicsSettings();
+		settings.mDeterministicSimulation = true;
+		physicsSystem->SetPhysicsSettings(settings);
+	}
 	physicsSystem->OptimizeBroadPhase();
+	if (asynchronous) {
+		physicsThread = std::thread(&Manager::physicsThreadLoop, this);
+	}
 }
 
 void engine::physics::Manager::Update(double deltaTime) {
+	if (!asynchronous) {
+		applyCommands();
+		simulate(deltaTime);
+		return;
+	}
+	// The physics thread is idle once the previous frame has been simulated, so it's safe to publish its results and
+	// apply commands before handing it the next frame
+	waitForStep();
+	frontSnapshot ^= 1;
+	publishedInterpolationAlpha = interpolationAlpha;
+	std::span<const ContactEvent> contactEvents = contactListener->GetEvents();
+	publishedContactEvents.assign(contactEvents.begin(), contactEvents.end());
+	publishedSensorEvents.assign(sensorEvents.begin(), sensorEvents.end());
+	publishedStepHashes.assign(stepHashes.begin(), stepHashes.end());
+	publishedStepStats.assign(stepStats.begin(), stepStats.end());
+	applyCommands();
+	captureUncapturedBodies();
+	{
+		std::lock_guard<std::mutex> lock(stepMutex);
+		requestedDeltaTime = deltaTime;
+		stepRequested = true;
+	}
+	stepCondition.notify_all();
+}
+
+void engine::physics::Manager::simulate(double deltaTime) {
+	contactListener->Reset();
+	sensorEvents.clear();
+	stepHashes.clear();
+	stepStats.clear();
 	if (!enabled) {
 		return;
 	}
-	double simulatedDeltaTime = 0.0;
-	for (; (simulatedDeltaTime + maxDeltaTimeStep) < deltaTime; simulatedDeltaTime += maxDeltaTimeStep) {
-		application->FixedUpdate(maxDeltaTimeStep);
-		physicsSystem->Update(maxDeltaTimeStepf, 1, 1, tempAllocator.get(), jobSystem.get());
+	if (stepMode == StepMode::Remainder) {
+		double simulatedDeltaTime = 0.0;
+		for (; (simulatedDeltaTime + maxDeltaTimeStep) < deltaTime; simulatedDeltaTime += maxDeltaTimeStep) {
+			step(maxDeltaTimeStep);
+		}
+		step(deltaTime - simulatedDeltaTime);
+		interpolationAlpha = 1.0;
+	} else {
+		accumulatedTime += deltaTime;
+		auto steps = std::uint32_t(accumulatedTime / maxDeltaTimeStep);
+		if (steps > maxSubsteps) {
+			// Dropping the excess time keeps a slow frame from making the next frame even slower
+			engine::log::Debug("Physics fell behind by %u steps, dropping the excess time", steps - maxSubsteps);
+			accumulatedTime = std::fmod(accumulatedTime, maxDeltaTimeStep) + (maxSubsteps * maxDeltaTimeStep);
+			steps = maxSubsteps;
+		}
+		for (std::uint32_t i = 0; i < steps; i++) {
+			// Only the step that ends the frame is interpolated, so earlier steps do not need to record anything
+			if (i == steps - 1) {
+				recordPreviousTransforms();
+			}
+			step(maxDeltaTimeStep);
+			accumulatedTime -= maxDeltaTimeStep;
+		}
+		accumulatedTime = std::max(accumulatedTime, 0.0);
+		interpolationAlpha = std::clamp(accumulatedTime / maxDeltaTimeStep, 0.0, 1.0);
+	}
+	contactListener->Finalize();
+}
+
+void engine::physics::Manager::step(double deltaTime) {
+	if (fixedUpdate || application) {
+		// Free functions called from the fixed update must operate on the world that is being stepped
+		Manager* previousManager = SetCurrentManager(this);
+		if (fixedUpdate) {
+			fixedUpdate(deltaTime);
+		} else {
+			application->FixedUpdate(deltaTime);
+		}
+		SetCurrentManager(previousManager);
+	}
+	float deltaTimef = (deltaTime == maxDeltaTimeStep) ? maxDeltaTimeStepf : float(deltaTime);
+	auto stepStart = std::chrono::steady_clock::now();
+	{
+		engine::profile::Scope scope("Physics Step");
+		physicsSystem->Update(deltaTimef, 1, 1, tempAllocator.get(), jobSystem.get());
+	}
+	auto stepEnd = std::chrono::steady_clock::now();
+	stepCount++;
+	updateSensors();
+	std::uint32_t contactManifolds = contactListener->TakeContactCount();
+	lastContactManifolds = contactManifolds;
+	if (contactManifolds > peakContactManifolds) {
+		peakContactManifolds = contactManifolds;
+		// Each manifold takes a contact constraint
+		if (contactManifolds >= maxContactConstraints) {
+			engine::log::Error("Contact manifolds have reached the contact constraint limit of %u, additional contacts are being ignored", maxContactConstraints);
+		}
+	}
+	PhysicsStepStats& stats = stepStats.emplace_back(PhysicsStepStats{
+		.Duration = std::chrono::duration<double>(stepEnd - stepStart).count(),
+		.Bodies = physicsSystem->GetNumBodies(),
+		.ActiveBodies = physicsSystem->GetNumActiveBodies(),
+		.ContactManifolds = contactManifolds,
+		.TempAllocatorUsage = tempAllocator->TakeStepHighWaterMark(),
+	});
+	if (engine::profile::IsCapturing()) {
+		engine::profile::RecordCounter("Physics Bodies", (double)stats.Bodies);
+		engine::profile::RecordCounter("Physics Active Bodies", (double)stats.ActiveBodies);
+		engine::profile::RecordCounter("Physics Contact Manifolds", (double)stats.ContactManifolds);
+		engine::profile::RecordCounter("Physics Temp Allocator Usage", (double)stats.TempAllocatorUsage);
+	}
+	if (deterministic) {
+		stepHashes.push_back(HashState());
+	}
+}
+
+void engine::physics::Manager::recordPreviousTransforms() {
+	if (previousTransforms.empty()) {
+		previousTransforms.resize(physicsSystem->GetMaxBodies());
+	}
+	physicsSystem->GetActiveBodies(activeBodies);
+	const JPH::BodyLockInterfaceNoLock& lockInterface = physicsSystem->GetBodyLockInterfaceNoLock();
+	for (JPH::BodyID bodyID : activeBodies) {
+		const JPH::Body* body = lockInterface.TryGetBody(bodyID);
+		if (!body) {
+			continue;
+		}
+		previousTransforms[bodyID.GetIndex()] = previousTransform{
+			.Position = body->GetPosition(),
+			.Rotation = body->GetRotation(),
+			.Step = stepCount,
+		};
+	}
+}
+
+std::span<const engine::physics::ContactEvent> engine::physics::Manager::GetContactEvents() {
+	if (asynchronous) {
+		return publishedContactEvents;
 	}
-	double remainingTime = deltaTime - simulatedDeltaTime;
-	application->FixedUpdate(remainingTime);
-	physicsSystem->Update(float(remainingTime), 1, 1, tempAllocator.get(), jobSystem.get());
+	return contactListener->GetEvents();
+}
+
+std::uint32_t engine::physics::Manager::GetMaxNumberOfBodies() {
+	return physicsSystem->GetMaxBodies();
+}
+
+std::span<const engine::physics::PhysicsStepStats> engine::physics::Manager::GetStepStats() {
+	if (asynchronous) {
+		return publishedStepStats;
+	}
+	return stepStats;
+}
+
+engine::physics::PhysicsCounters engine::physics::Manager::GetCounters() {
+	return PhysicsCounters{
+		.Bodies = physicsSystem->GetNumBodies(),
+		.MaxBodies = physicsSystem->GetMaxBodies(),
+		.ContactManifolds = lastContactManifolds,
+		.PeakContactManifolds = peakContactManifolds,
+		.MaxContactConstraints = maxContactConstraints,
+		.PeakContactEvents = contactListener->GetPeakEventCount(),
+		.MaxContactEvents = maxContactEvents,
+		.TempAllocatorHighWaterMark = tempAllocator->GetHighWaterMark(),
+		.TempAllocatorCapacity = tempAllocator->GetCapacity(),
+		.TempAllocatorOverflows = tempAllocator->GetOverflowCount(),
+	};
+}
+
+void engine::physics::Manager::ResetPeakCounters() {
+	peakContactManifolds = lastContactManifolds.load();
+	contactListener->ResetPeakEventCount();
+	tempAllocator->ResetHighWaterMark();
 }
 
 void engine::physics::Manager::SetUpdateRate(double rate) {
+	Synchronize();
 	maxDeltaTimeStep = 1.0 / rate;
 	maxDeltaTimeStepf = (float)maxDeltaTimeStep;
 }
 
+void engine::physics::Manager::SetMaxSubsteps(std::uint32_t maxSubsteps) {
+	Synchronize();
+	this->maxSubsteps = std::max(maxSubsteps, 1u);
+}
+
+double engine::physics::Manager::GetInterpolationAlpha() {
+	return asynchronous ? publishedInterpolationAlpha : interpolationAlpha;
+}
+
 void engine::physics::Manager::OptimizeBroadPhase() {
 	physicsSystem->OptimizeBroadPhase();
 }
@@ -197,83 +536,214 @@ void engine::physics::Manager::SetGravity(glm::vec3 gravity) {
 	physicsSystem->SetGravity(toJPH(gravity));
 }
 
-std::vector<engine::physics::RayResult> engine::physics::Manager::CastRay(glm::vec3 origin, glm::vec3 directionWithMagnitude, RayFilter filter) {
-	JPH::RayCast ray{toJPH(origin), toJPH(directionWithMagnitude)};
-	std::vector<RayResult> hitBodies;
-	switch (filter) {
-		case RayFilter::AllHit: {
-			JPH::AllHitCollisionCollector<JPH::RayCastBodyCollector> collector;
-			physicsSystem->GetBroadPhaseQuery().CastRay(ray, collector);
-			collector.Sort();
-			auto numOfHits = size_t(collector.mHits.size());
-			hitBodies.reserve(numOfHits);
-			JPH::BroadPhaseCastResult* results = collector.mHits.data();
-			for (size_t i = 0; i < numOfHits; i++) {
-				auto& result = results[i];
-				hitBodies.emplace_back(RayResult{
-					.Body = Body(result.mBodyID.GetIndexAndSequenceNumber(), false),
-					.ContactPoint = origin + (result.mFraction * (directionWithMagnitude)),
-				});
-			}
-			break;
+void engine::physics::Manager::ReadTransforms(std::span<const Body> bodies, std::span<glm::vec3> positions, std::span<glm::quat> rotations) {
+	assert(positions.size() >= bodies.size() && rotations.size() >= bodies.size());
+	const JPH::BodyLockInterfaceNoLock& lockInterface = physicsSystem->GetBodyLockInterfaceNoLock();
+	// Bodies are only read directly while the physics thread is idle. Otherwise, bodies that are missing from the
+	// snapshot (such as bodies created since the last frame) are not available until the next frame.
+	bool canReadBodies = true;
+	if (asynchronous) {
+		std::lock_guard<std::mutex> lock(stepMutex);
+		canReadBodies = !stepRequested;
+	}
+	for (size_t i = 0; i < bodies.size(); i++) {
+		auto bodyID = static_cast<JPH::BodyID>(bodies[i].id);
+		if (const snapshotTransform* snapshot = getSnapshot(bodyID)) {
+			positions[i] = toGLM(snapshot->Position);
+			rotations[i] = toGLM(snapshot->Rotation);
+			continue;
 		}
-		case RayFilter::AnyHit: {
-			JPH::AnyHitCollisionCollector<JPH::RayCastBodyCollector> collector;
-			physicsSystem->GetBroadPhaseQuery().CastRay(ray, collector);
-			if (collector.HadHit()) {
-				hitBodies.reserve(1);
-				hitBodies.push_back(RayResult{
-					.Body = Body(collector.mHit.mBodyID.GetIndexAndSequenceNumber(), false),
-					.ContactPoint = origin + (collector.mHit.mFraction * (directionWithMagnitude)),
-				});
-			}
-			break;
+		const JPH::Body* body = canReadBodies ? lockInterface.TryGetBody(bodyID) : nullptr;
+		if (!body) {
+			positions[i] = glm::vec3(0.0f);
+			rotations[i] = glm::identity<glm::quat>();
+			continue;
 		}
-		case RayFilter::ClosestHit: {
-			JPH::ClosestHitCollisionCollector<JPH::RayCastBodyCollector> collector;
-			physicsSystem->GetBroadPhaseQuery().CastRay(ray, collector);
-			if (collector.HadHit()) {
-				hitBodies.reserve(1);
-				hitBodies.push_back(RayResult{
-					.Body = Body(collector.mHit.mBodyID.GetIndexAndSequenceNumber(), false),
-					.ContactPoint = origin + (collector.mHit.mFraction * (directionWithMagnitude)),
-				});
+		positions[i] = toGLM(body->GetPosition());
+		rotations[i] = toGLM(body->GetRotation());
+	}
+}
+
+std::size_t engine::physics::Manager::ReadActiveTransforms(std::span<std::uint32_t> ids, std::span<glm::vec3> positions, std::span<glm::quat> rotations) {
+	if (asynchronous) {
+		const JPH::BodyIDVector& capturedBodies = snapshotBodies[frontSnapshot];
+		size_t count = std::min({capturedBodies.size(), ids.size(), positions.size(), rotations.size()});
+		size_t written = 0;
+		for (size_t i = 0; i < count; i++) {
+			const snapshotTransform* snapshot = getSnapshot(capturedBodies[i]);
+			if (!snapshot) {
+				continue;
 			}
-			break;
+			ids[written] = capturedBodies[i].GetIndexAndSequenceNumber();
+			positions[written] = toGLM(snapshot->Position);
+			rotations[written] = toGLM(snapshot->Rotation);
+			written++;
 		}
-		case RayFilter::FurthestHit: {
-			FurthestHitCollisionCollector<JPH::RayCastBodyCollector> collector;
-			physicsSystem->GetBroadPhaseQuery().CastRay(ray, collector);
-			if (collector.HadHit()) {
-				hitBodies.reserve(1);
-				hitBodies.push_back(RayResult{
-					.Body = Body(collector.mHit.mBodyID.GetIndexAndSequenceNumber(), false),
-					.ContactPoint = origin + (collector.mHit.mFraction * (directionWithMagnitude)),
-				});
+		return written;
+	}
+	physicsSystem->GetActiveBodies(activeBodies);
+	size_t count = std::min({activeBodies.size(), ids.size(), positions.size(), rotations.size()});
+	const JPH::BodyLockInterfaceNoLock& lockInterface = physicsSystem->GetBodyLockInterfaceNoLock();
+	size_t written = 0;
+	for (size_t i = 0; i < count; i++) {
+		const JPH::Body* body = lockInterface.TryGetBody(activeBodies[i]);
+		if (!body) {
+			continue;
+		}
+		ids[written] = activeBodies[i].GetIndexAndSequenceNumber();
+		positions[written] = toGLM(body->GetPosition());
+		rotations[written] = toGLM(body->GetRotation());
+		written++;
+	}
+	return written;
+}
+
+void engine::physics::Manager::ReadInterpolatedTransforms(std::span<const Body> bodies, std::span<glm::vec3> positions, std::span<glm::quat> rotations) {
+	assert(positions.size() >= bodies.size() && rotations.size() >= bodies.size());
+	if (asynchronous) {
+		// The snapshot already holds both transforms, and bodies that are not in it are not interpolated
+		auto alpha = float(publishedInterpolationAlpha);
+		ReadTransforms(bodies, positions, rotations);
+		for (size_t i = 0; i < bodies.size(); i++) {
+			if (const snapshotTransform* snapshot = getSnapshot(static_cast<JPH::BodyID>(bodies[i].id))) {
+				positions[i] = glm::mix(toGLM(snapshot->PreviousPosition), positions[i], alpha);
+				rotations[i] = glm::slerp(toGLM(snapshot->PreviousRotation), rotations[i], alpha);
 			}
-			break;
 		}
+		return;
+	}
+	const JPH::BodyLockInterfaceNoLock& lockInterface = physicsSystem->GetBodyLockInterfaceNoLock();
+	// The last step was simulated at stepCount - 1, so only transforms recorded for that step are interpolated
+	std::uint64_t lastStep = stepCount - 1;
+	auto alpha = float(interpolationAlpha);
+	for (size_t i = 0; i < bodies.size(); i++) {
+		auto bodyID = static_cast<JPH::BodyID>(bodies[i].id);
+		const JPH::Body* body = lockInterface.TryGetBody(bodyID);
+		if (!body) {
+			positions[i] = glm::vec3(0.0f);
+			rotations[i] = glm::identity<glm::quat>();
+			continue;
+		}
+		glm::vec3 position = toGLM(body->GetPosition());
+		glm::quat rotation = toGLM(body->GetRotation());
+		if (!previousTransforms.empty() && previousTransforms[bodyID.GetIndex()].Step == lastStep) {
+			const previousTransform& previous = previousTransforms[bodyID.GetIndex()];
+			position = glm::mix(toGLM(previous.Position), position, alpha);
+			rotation = glm::slerp(toGLM(previous.Rotation), rotation, alpha);
+		}
+		positions[i] = position;
+		rotations[i] = rotation;
+	}
+}
+
+std::uint32_t engine::physics::Manager::GetNumberOfActiveBodies() {
+	return physicsSystem->GetNumActiveBodies();
+}
+
+bool engine::physics::Manager::getCreationSettings(const JPH::Shape* shape, const BodyCreationProperties& properties, JPH::BodyCreationSettings& settings) {
+	Layer layer = properties.Layer.value_or(properties.MotionType == MotionType::Static ? Layers::NON_MOVING : Layers::MOVING);
+	if (layer >= layerCount) {
+		engine::log::Error("Physics layer %u does not exist", (std::uint32_t)layer);
+		return false;
 	}
-	return hitBodies;
+	settings = JPH::BodyCreationSettings(shape, toJPH(properties.Position), toJPH(properties.Rotation), toJPH(properties.MotionType), layer);
+	settings.mMotionQuality = toJPH(properties.MotionQuality);
+	settings.mUserData = properties.UserData;
+	return true;
 }
 
-std::unique_ptr<engine::physics::Body> engine::physics::Manager::CreateBody(JPH::Shape* shape, const BodyCreationProperties properties) {
+std::unique_ptr<engine::physics::Body> engine::physics::Manager::CreateBody(const JPH::Shape* shape, const BodyCreationProperties properties) {
 	JPH::BodyInterface& bodyInterface = physicsSystem->GetBodyInterface();
-	auto layer = properties.MotionType == MotionType::Static ? Layers::NON_MOVING : Layers::MOVING;
 	auto activate = properties.MotionType == MotionType::Static ? JPH::EActivation::DontActivate : JPH::EActivation::Activate;
-	JPH::BodyCreationSettings settings(shape, toJPH(properties.Position), toJPH(properties.Rotation), toJPH(properties.MotionType), layer);
-	settings.mMotionQuality = toJPH(properties.MotionQuality);
+	JPH::BodyCreationSettings settings;
+	if (!getCreationSettings(shape, properties, settings)) {
+		return nullptr;
+	}
 	JPH::BodyID bodyID = bodyInterface.CreateAndAddBody(settings, activate);
 	if (bodyID.IsInvalid()) {
-		delete (shape);
+		// The shape is reference counted, so it is released along with the creation settings
 		engine::log::Debug("Physics bodies limit has been hit, cannot create more bodies");
 		return nullptr;
 	}
-	return std::unique_ptr<Body>(new Body(bodyID.GetIndexAndSequenceNumber()));
+	if (asynchronous) {
+		uncapturedBodies.push_back(bodyID);
+	}
+	return std::unique_ptr<Body>(new Body(bodyID.GetIndexAndSequenceNumber(), this));
+}
+
+std::vector<engine::physics::Body> engine::physics::Manager::CreateBodies(std::span<const BatchBodyCreationProperties> properties, bool optimizeBroadPhase) {
+	JPH::BodyInterface& bodyInterface = physicsSystem->GetBodyInterface();
+	std::vector<Body> bodies;
+	bodies.reserve(properties.size());
+	// Activation is decided per batch, so static bodies are added separately from the rest
+	std::vector<JPH::BodyID> staticIDs;
+	std::vector<JPH::BodyID> movingIDs;
+	// Bodies that could not be created are left invalid, so that the results line up with the given properties
+	for (size_t i = 0; i < properties.size(); i++) {
+		const BatchBodyCreationProperties& bodyProperties = properties[i];
+		JPH::ShapeRefC shape = createShape(bodyProperties.Shape, bodyProperties.Body.Mass);
+		if (shape == nullptr) {
+			bodies.emplace_back();
+			continue;
+		}
+		JPH::BodyCreationSettings settings;
+		if (!getCreationSettings(shape, bodyProperties.Body, settings)) {
+			bodies.emplace_back();
+			continue;
+		}
+		JPH::Body* body = bodyInterface.CreateBody(settings);
+		if (!body) {
+			engine::log::Debug("Physics bodies limit has been hit, %zu of %zu bodies were not created", properties.size() - i, properties.size());
+			bodies.resize(properties.size());
+			break;
+		}
+		if (bodyProperties.Body.MotionType == MotionType::Static) {
+			staticIDs.push_back(body->GetID());
+		} else {
+			movingIDs.push_back(body->GetID());
+		}
+		bodies.push_back(Body(body->GetID().GetIndexAndSequenceNumber(), this, false));
+	}
+
+	if (!staticIDs.empty()) {
+		auto addState = bodyInterface.AddBodiesPrepare(staticIDs.data(), (int)staticIDs.size());
+		bodyInterface.AddBodiesFinalize(staticIDs.data(), (int)staticIDs.size(), addState, JPH::EActivation::DontActivate);
+	}
+	if (!movingIDs.empty()) {
+		auto addState = bodyInterface.AddBodiesPrepare(movingIDs.data(), (int)movingIDs.size());
+		bodyInterface.AddBodiesFinalize(movingIDs.data(), (int)movingIDs.size(), addState, JPH::EActivation::Activate);
+	}
+	if (asynchronous) {
+		uncapturedBodies.insert(uncapturedBodies.end(), staticIDs.begin(), staticIDs.end());
+		uncapturedBodies.insert(uncapturedBodies.end(), movingIDs.begin(), movingIDs.end());
+	}
+	if (optimizeBroadPhase && (!staticIDs.empty() || !movingIDs.empty())) {
+		physicsSystem->OptimizeBroadPhase();
+	}
+	return bodies;
+}
+
+void engine::physics::Manager::DestroyBodies(std::span<const Body> bodies) {
+	if (bodies.empty()) {
+		return;
+	}
+	std::vector<JPH::BodyID> bodyIDs;
+	bodyIDs.reserve(bodies.size());
+	for (const auto& body: bodies) {
+		// Bodies that CreateBodies could not create are invalid, and were never added
+		if (body.IsValid()) {
+			bodyIDs.push_back(static_cast<JPH::BodyID>(body.id));
+		}
+	}
+	if (bodyIDs.empty()) {
+		return;
+	}
+	JPH::BodyInterface& bodyInterface = physicsSystem->GetBodyInterface();
+	bodyInterface.RemoveBodies(bodyIDs.data(), (int)bodyIDs.size());
+	bodyInterface.DestroyBodies(bodyIDs.data(), (int)bodyIDs.size());
 }
 
 std::unique_ptr<engine::physics::Character> engine::physics::Manager::CreateCharacter(const CharacterCreationProperties properties) {
-	float halfHeight = 0.5f * properties.Height;
 	float radius = 0.5f * properties.Width;
 
 	JPH::CharacterSettings characterSettings;
@@ -285,20 +755,51 @@ std::unique_ptr<engine::physics::Character> engine::physics::Manager::CreateChar
 	characterSettings.mSupportingVolume = JPH::Plane(JPH::Vec3::sAxisY(), -radius);
 	characterSettings.mFriction = 0.5f;
 
-	auto shape = JPH::RotatedTranslatedShapeSettings(
-		JPH::Vec3(0, halfHeight + radius, 0),
-		JPH::Quat::sIdentity(),
-		new JPH::CapsuleShape(halfHeight, radius)).Create().Get();
-	characterSettings.mShape = shape;
+	characterSettings.mShape = createCharacterShape(properties);
 
 	JPH::uint64 inUserData = 0;
 	auto character = new JPH::Character(&characterSettings, toJPH(properties.Position), toJPH(properties.Rotation), inUserData, physicsSystem.get());
-	return std::unique_ptr<Character>(new Character(character));
+	return std::unique_ptr<Character>(new Character(character, this));
+}
+
+std::unique_ptr<engine::physics::VirtualCharacter> engine::physics::Manager::CreateVirtualCharacter(const CharacterCreationProperties properties) {
+	float radius = 0.5f * properties.Width;
+
+	JPH::CharacterVirtualSettings characterSettings;
+	characterSettings.mMass = properties.Weight;
+	characterSettings.mMaxSlopeAngle = properties.MaxSlopeAngle;
+	// The supporting volume should be shifted, so that the bottom of the capsule is at 0.0
+	characterSettings.mSupportingVolume = JPH::Plane(JPH::Vec3::sAxisY(), -radius);
+	characterSettings.mShape = createCharacterShape(properties);
+
+	auto character = new JPH::CharacterVirtual(&characterSettings, toJPH(properties.Position), toJPH(properties.Rotation), physicsSystem.get());
+	return std::unique_ptr<VirtualCharacter>(new VirtualCharacter(character, properties.GravityFactor, this));
+}
+
+JPH::ShapeRefC engine::physics::Manager::createCharacterShape(const CharacterCreationProperties& properties) {
+	float halfHeight = 0.5f * properties.Height;
+	float radius = 0.5f * properties.Width;
+	return JPH::RotatedTranslatedShapeSettings(
+		JPH::Vec3(0, halfHeight + radius, 0),
+		JPH::Quat::sIdentity(),
+		new JPH::CapsuleShape(halfHeight, radius)).Create().Get();
 }
 
 engine::physics::Manager::~Manager() {
-	delete JPH::Factory::sInstance;
-	JPH::Factory::sInstance = nullptr;
+	if (physicsThread.joinable()) {
+		{
+			std::lock_guard<std::mutex> lock(stepMutex);
+			stopping = true;
+		}
+		stepCondition.notify_all();
+		physicsThread.join();
+	}
+	// Jolt's objects must be destroyed before its factory is released
+	contactListener.reset();
+	physicsSystem.reset();
+	shapeCache.clear();
+	cookedShapeCache.clear();
+	releaseJolt();
 }
 
 void engine::physics::Manager::Enable() {
@@ -310,15 +811,30 @@ void engine::physics::Manager::Disable() {
 }
 
 void engine::physics::Enable() {
-	GlobalManager->Enable();
+	GetCurrentManager()->Enable();
 }
 
 void engine::physics::Disable() {
-	GlobalManager->Disable();
+	GetCurrentManager()->Disable();
+}
+
+engine::physics::Manager* engine::physics::GetCurrentManager() {
+	return currentManager ? currentManager : GlobalManager;
+}
+
+engine::physics::Manager* engine::physics::SetCurrentManager(Manager* manager) {
+	Manager* previousManager = currentManager;
+	currentManager = manager;
+	return previousManager;
+}
+
+void engine::physics::Manager::SetFixedUpdate(std::function<void(double)> function) {
+	Synchronize();
+	fixedUpdate = std::move(function);
 }
 
 void engine::physics::Initialize(engine::Application* application) {
-	GlobalManager = new Manager(application);
+	GlobalManager = new Manager(application, application->StartOptions().Physics);
 }
 
 void engine::physics::Update(double deltaTime) {
@@ -330,25 +846,57 @@ void engine::physics::Terminate() {
 }
 
 void engine::physics::SetUpdateRate(double rate) {
-	GlobalManager->SetUpdateRate(rate);
+	GetCurrentManager()->SetUpdateRate(rate);
+}
+
+void engine::physics::SetMaxSubsteps(std::uint32_t maxSubsteps) {
+	GetCurrentManager()->SetMaxSubsteps(maxSubsteps);
+}
+
+double engine::physics::GetInterpolationAlpha() {
+	return GetCurrentManager()->GetInterpolationAlpha();
 }
 
 glm::vec3 engine::physics::GetGravity() {
-	return GlobalManager->GetGravity();
+	return GetCurrentManager()->GetGravity();
 }
 
 void engine::physics::SetGravity(glm::vec3 gravity) {
-	GlobalManager->SetGravity(gravity);
+	GetCurrentManager()->SetGravity(gravity);
 }
 
 std::uint32_t engine::physics::GetMaxNumberOfBodies() {
-	return maxPhysicsBodies;
+	return GetCurrentManager()->GetMaxNumberOfBodies();
+}
+
+engine::physics::PhysicsCounters engine::physics::GetCounters() {
+	return GetCurrentManager()->GetCounters();
+}
+
+void engine::physics::ResetPeakCounters() {
+	GetCurrentManager()->ResetPeakCounters();
+}
+
+std::span<const engine::physics::PhysicsStepStats> engine::physics::GetStepStats() {
+	return GetCurrentManager()->GetStepStats();
+}
+
+std::span<const engine::physics::ContactEvent> engine::physics::GetContactEvents() {
+	return GetCurrentManager()->GetContactEvents();
+}
+
+void engine::physics::ReadTransforms(std::span<const Body> bodies, std::span<glm::vec3> positions, std::span<glm::quat> rotations) {
+	GetCurrentManager()->ReadTransforms(bodies, positions, rotations);
+}
+
+std::size_t engine::physics::ReadActiveTransforms(std::span<std::uint32_t> ids, std::span<glm::vec3> positions, std::span<glm::quat> rotations) {
+	return GetCurrentManager()->ReadActiveTransforms(ids, positions, rotations);
 }
 
-std::vector<engine::physics::RayResult> engine::physics::CastRay(glm::vec3 origin, glm::vec3 direction, float magnitude, RayFilter filter) {
-	return GlobalManager->CastRay(origin, glm::normalize(direction) * magnitude, filter);
+void engine::physics::ReadInterpolatedTransforms(std::span<const Body> bodies, std::span<glm::vec3> positions, std::span<glm::quat> rotations) {
+	GetCurrentManager()->ReadInterpolatedTransforms(bodies, positions, rotations);
 }
 
-std::vector<engine::physics::RayResult> engine::physics::CastRay(glm::vec3 origin, glm::vec3 directionWithMagnitude, RayFilter filter) {
-	return GlobalManager->CastRay(origin, directionWithMagnitude, filter);
+std::uint32_t engine::physics::GetNumberOfActiveBodies() {
+	return GetCurrentManager()->GetNumberOfActiveBodies();
 }
@@ -0,0 +1,24 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <engine/physics/manager.hpp>
+#include <engine/profile/profile.hpp>
+#include <new>
+
+#if defined(JPH_EXTERNAL_PROFILE)
+
+// Jolt opens a measurement for each of its scopes and jobs, such as the broad phase, narrow phase and solver, so each
+// measurement holds an engine scope within the space that Jolt reserves for it.
+JPH::ExternalProfileMeasurement::ExternalProfileMeasurement(const char* inName, JPH::uint32 inColor) {
+	static_assert(sizeof(engine::profile::Scope) <= sizeof(mUserData), "Profile scopes must fit within Jolt's measurements");
+	new (mUserData) engine::profile::Scope(inName);
+}
+
+JPH::ExternalProfileMeasurement::~ExternalProfileMeasurement() {
+	std::launder(reinterpret_cast<engine::profile::Scope*>(mUserData))->~Scope();
+}
+
+#endif // JPH_EXTERNAL_PROFILE
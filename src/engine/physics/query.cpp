@@ -0,0 +1,271 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <engine/physics/manager.hpp>
+#include <algorithm>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <Jolt/Physics/Body/BodyLock.h>
+#include <Jolt/Physics/Collision/CastResult.h>
+#include <Jolt/Physics/Collision/CollideShape.h>
+#include <Jolt/Physics/Collision/ShapeCast.h>
+#include <Jolt/Physics/Collision/Shape/BoxShape.h>
+#include <Jolt/Physics/Collision/Shape/CapsuleShape.h>
+#include <Jolt/Physics/Collision/Shape/SphereShape.h>
+
+// Disables common warnings triggered by Jolt
+JPH_SUPPRESS_WARNINGS
+
+// The fewest rays that a single job will cast when casting rays in a batch. Smaller batches are not worth the overhead
+// of scheduling a job.
+const size_t minRaysPerJob = 64;
+
+// Modeled from Jolt/Physics/Collision/CollisionCollectorImpl.h::ClosestHitCollisionCollector
+template<class CollectorType>
+class FurthestHitCollisionCollector : public CollectorType {
+public:
+	void Reset() override {
+		CollectorType::Reset();
+		mHadHit = false;
+	}
+	void AddHit(const typename CollectorType::ResultType& inResult) override {
+		float early_out = inResult.GetEarlyOutFraction();
+		if (!mHadHit || early_out > mHit.GetEarlyOutFraction()) {
+			mHit = inResult;
+			mHadHit = true;
+		}
+	}
+	inline bool HadHit() const {
+		return mHadHit;
+	}
+	typename CollectorType::ResultType mHit;
+
+private:
+	bool mHadHit = false;
+};
+
+// Runs the query using the collector that matches the filter, then passes each hit to onHit in the filter's order.
+template<class CollectorType, class QueryFunc, class HitFunc>
+void collectHits(engine::physics::RayFilter filter, const QueryFunc& query, const HitFunc& onHit) {
+	switch (filter) {
+		case engine::physics::RayFilter::AllHit: {
+			JPH::AllHitCollisionCollector<CollectorType> collector;
+			query(collector);
+			collector.Sort();
+			for (const auto& hit: collector.mHits) {
+				onHit(hit);
+			}
+			break;
+		}
+		case engine::physics::RayFilter::AnyHit: {
+			JPH::AnyHitCollisionCollector<CollectorType> collector;
+			query(collector);
+			if (collector.HadHit()) {
+				onHit(collector.mHit);
+			}
+			break;
+		}
+		case engine::physics::RayFilter::ClosestHit: {
+			JPH::ClosestHitCollisionCollector<CollectorType> collector;
+			query(collector);
+			if (collector.HadHit()) {
+				onHit(collector.mHit);
+			}
+			break;
+		}
+		case engine::physics::RayFilter::FurthestHit: {
+			FurthestHitCollisionCollector<CollectorType> collector;
+			query(collector);
+			if (collector.HadHit()) {
+				onHit(collector.mHit);
+			}
+			break;
+		}
+	}
+}
+
+engine::physics::LayerMaskFilter::LayerMaskFilter(LayerMask layers) : layers(layers) {}
+
+bool engine::physics::LayerMaskFilter::ShouldCollide(JPH::ObjectLayer layer) const {
+	return layer < MaxLayers && (layers & (LayerMask(1) << layer)) != 0;
+}
+
+glm::vec3 engine::physics::Manager::getSurfaceNormal(JPH::BodyID bodyID, const JPH::SubShapeID& subShapeID, glm::vec3 point, std::uint64_t& userData) {
+	JPH::BodyLockRead lock(physicsSystem->GetBodyLockInterface(), bodyID);
+	if (!lock.Succeeded()) {
+		userData = 0;
+		return glm::vec3(0.0f);
+	}
+	userData = lock.GetBody().GetUserData();
+	return toGLM(lock.GetBody().GetWorldSpaceSurfaceNormal(subShapeID, toJPH(point)));
+}
+
+std::vector<engine::physics::RayResult> engine::physics::Manager::CastRay(glm::vec3 origin, glm::vec3 directionWithMagnitude, RayFilter filter, LayerMask layers) {
+	JPH::RRayCast ray{toJPH(origin), toJPH(directionWithMagnitude)};
+	LayerMaskFilter layerFilter(layers);
+	std::vector<RayResult> hitBodies;
+	collectHits<JPH::CastRayCollector>(filter, [&](JPH::CastRayCollector& collector) {
+		physicsSystem->GetNarrowPhaseQuery().CastRay(ray, JPH::RayCastSettings(), collector, {}, layerFilter);
+	}, [&](const JPH::RayCastResult& hit) {
+		RayResult& result = hitBodies.emplace_back(RayResult{
+			.Body = Body(hit.mBodyID.GetIndexAndSequenceNumber(), this, false),
+			.ContactPoint = origin + (hit.mFraction * directionWithMagnitude),
+		});
+		result.Normal = getSurfaceNormal(hit.mBodyID, hit.mSubShapeID2, result.ContactPoint, result.UserData);
+	});
+	return hitBodies;
+}
+
+engine::physics::RayResult engine::physics::Manager::castSingleRay(const Ray& ray, RayFilter filter, LayerMask layers) {
+	JPH::RRayCast rayCast{toJPH(ray.Origin), toJPH(ray.DirectionWithMagnitude)};
+	LayerMaskFilter layerFilter(layers);
+	RayResult result{};
+	collectHits<JPH::CastRayCollector>((filter == RayFilter::AllHit) ? RayFilter::ClosestHit : filter, [&](JPH::CastRayCollector& collector) {
+		physicsSystem->GetNarrowPhaseQuery().CastRay(rayCast, JPH::RayCastSettings(), collector, {}, layerFilter);
+	}, [&](const JPH::RayCastResult& hit) {
+		result.Body = Body(hit.mBodyID.GetIndexAndSequenceNumber(), this, false);
+		result.ContactPoint = ray.Origin + (hit.mFraction * ray.DirectionWithMagnitude);
+		result.Normal = getSurfaceNormal(hit.mBodyID, hit.mSubShapeID2, result.ContactPoint, result.UserData);
+	});
+	return result;
+}
+
+void engine::physics::Manager::CastRays(std::span<const Ray> rays, RayFilter filter, std::span<RayResult> results, LayerMask layers) {
+	assert(results.size() >= rays.size());
+	size_t jobCount = std::min((rays.size() + minRaysPerJob - 1) / minRaysPerJob, (size_t)jobSystem->GetMaxConcurrency());
+	if (jobCount <= 1) {
+		for (size_t i = 0; i < rays.size(); i++) {
+			results[i] = castSingleRay(rays[i], filter, layers);
+		}
+		return;
+	}
+
+	// Each job casts a contiguous range of rays, and waiting on the barrier lets this thread cast rays as well
+	size_t raysPerJob = (rays.size() + jobCount - 1) / jobCount;
+	std::vector<JPH::JobHandle> jobs;
+	jobs.reserve(jobCount);
+	for (size_t start = 0; start < rays.size(); start += raysPerJob) {
+		size_t end = std::min(start + raysPerJob, rays.size());
+		jobs.push_back(jobSystem->CreateJob("CastRays", JPH::Color::sGreen, [this, rays, filter, results, layers, start, end]() {
+			for (size_t i = start; i < end; i++) {
+				results[i] = castSingleRay(rays[i], filter, layers);
+			}
+		}));
+	}
+	JPH::JobSystem::Barrier* barrier = jobSystem->CreateBarrier();
+	barrier->AddJobs(jobs.data(), (JPH::uint)jobs.size());
+	jobSystem->WaitForJobs(barrier);
+	jobSystem->DestroyBarrier(barrier);
+}
+
+std::vector<engine::physics::ShapeCastResult> engine::physics::Manager::castShape(const JPH::Shape* shape, glm::mat4 transform, glm::vec3 directionWithMagnitude, RayFilter filter, LayerMask layers) {
+	auto shapeCast = JPH::RShapeCast::sFromWorldTransform(shape, JPH::Vec3::sReplicate(1.0f), toJPH(transform), toJPH(directionWithMagnitude));
+	JPH::ShapeCastSettings settings;
+	LayerMaskFilter layerFilter(layers);
+	std::vector<ShapeCastResult> hitBodies;
+	collectHits<JPH::CastShapeCollector>(filter, [&](JPH::CastShapeCollector& collector) {
+		physicsSystem->GetNarrowPhaseQuery().CastShape(shapeCast, settings, JPH::RVec3::sZero(), collector, {}, layerFilter);
+	}, [&](const JPH::ShapeCastResult& hit) {
+		// The penetration axis points from the cast shape into the body, so the body's surface faces the other way
+		glm::vec3 normal(0.0f);
+		if (hit.mPenetrationAxis.LengthSq() > 0.0f) {
+			normal = toGLM(-hit.mPenetrationAxis.Normalized());
+		}
+		JPH::BodyLockRead lock(physicsSystem->GetBodyLockInterface(), hit.mBodyID2);
+		hitBodies.push_back(ShapeCastResult{
+			.Body = Body(hit.mBodyID2.GetIndexAndSequenceNumber(), this, false),
+			.UserData = lock.Succeeded() ? lock.GetBody().GetUserData() : 0,
+			.ContactPoint = toGLM(hit.mContactPointOn2),
+			.Normal = normal,
+			.Fraction = hit.mFraction,
+		});
+	});
+	return hitBodies;
+}
+
+std::vector<engine::physics::ShapeCastResult> engine::physics::Manager::CastSphere(glm::vec3 origin, float radius, glm::vec3 directionWithMagnitude, RayFilter filter, LayerMask layers) {
+	JPH::SphereShape sphere(radius);
+	sphere.SetEmbedded();
+	return castShape(&sphere, glm::translate(glm::mat4(1.0f), origin), directionWithMagnitude, filter, layers);
+}
+
+std::vector<engine::physics::ShapeCastResult> engine::physics::Manager::CastCapsule(glm::vec3 origin, glm::quat rotation, float height, float radius, glm::vec3 directionWithMagnitude, RayFilter filter, LayerMask layers) {
+	JPH::CapsuleShape capsule(height / 2.0f, radius);
+	capsule.SetEmbedded();
+	return castShape(&capsule, glm::translate(glm::mat4(1.0f), origin) * glm::toMat4(rotation), directionWithMagnitude, filter, layers);
+}
+
+std::vector<engine::physics::Body> engine::physics::Manager::overlapShape(const JPH::Shape* shape, glm::mat4 transform, LayerMask layers) {
+	JPH::CollideShapeSettings settings;
+	LayerMaskFilter layerFilter(layers);
+	JPH::AllHitCollisionCollector<JPH::CollideShapeCollector> collector;
+	physicsSystem->GetNarrowPhaseQuery().CollideShape(shape, JPH::Vec3::sReplicate(1.0f), toJPH(transform), settings, JPH::RVec3::sZero(), collector, {}, layerFilter);
+	// A body may be hit by several of its sub shapes, so the hits are reduced to one per body
+	std::vector<JPH::BodyID> bodyIDs;
+	bodyIDs.reserve(collector.mHits.size());
+	for (const auto& hit: collector.mHits) {
+		bodyIDs.push_back(hit.mBodyID2);
+	}
+	std::sort(bodyIDs.begin(), bodyIDs.end());
+	bodyIDs.erase(std::unique(bodyIDs.begin(), bodyIDs.end()), bodyIDs.end());
+	std::vector<Body> bodies;
+	bodies.reserve(bodyIDs.size());
+	for (const auto& bodyID: bodyIDs) {
+		bodies.push_back(Body(bodyID.GetIndexAndSequenceNumber(), this, false));
+	}
+	return bodies;
+}
+
+std::vector<engine::physics::Body> engine::physics::Manager::OverlapSphere(glm::vec3 center, float radius, LayerMask layers) {
+	JPH::SphereShape sphere(radius);
+	sphere.SetEmbedded();
+	return overlapShape(&sphere, glm::translate(glm::mat4(1.0f), center), layers);
+}
+
+std::vector<engine::physics::Body> engine::physics::Manager::OverlapBox(glm::vec3 center, glm::quat rotation, glm::vec3 size, LayerMask layers) {
+	auto halfExtents = toJPH(size * 0.5f);
+	JPH::BoxShape box(halfExtents, std::min(halfExtents.ReduceMin(), JPH::cDefaultConvexRadius));
+	box.SetEmbedded();
+	return overlapShape(&box, glm::translate(glm::mat4(1.0f), center) * glm::toMat4(rotation), layers);
+}
+
+std::vector<engine::physics::Body> engine::physics::Manager::OverlapCapsule(glm::vec3 center, glm::quat rotation, float height, float radius, LayerMask layers) {
+	JPH::CapsuleShape capsule(height / 2.0f, radius);
+	capsule.SetEmbedded();
+	return overlapShape(&capsule, glm::translate(glm::mat4(1.0f), center) * glm::toMat4(rotation), layers);
+}
+
+std::vector<engine::physics::RayResult> engine::physics::CastRay(glm::vec3 origin, glm::vec3 direction, float magnitude, RayFilter filter, LayerMask layers) {
+	return GetCurrentManager()->CastRay(origin, glm::normalize(direction) * magnitude, filter, layers);
+}
+
+std::vector<engine::physics::RayResult> engine::physics::CastRay(glm::vec3 origin, glm::vec3 directionWithMagnitude, RayFilter filter, LayerMask layers) {
+	return GetCurrentManager()->CastRay(origin, directionWithMagnitude, filter, layers);
+}
+
+void engine::physics::CastRays(std::span<const Ray> rays, RayFilter filter, std::span<RayResult> results, LayerMask layers) {
+	GetCurrentManager()->CastRays(rays, filter, results, layers);
+}
+
+std::vector<engine::physics::ShapeCastResult> engine::physics::CastSphere(glm::vec3 origin, float radius, glm::vec3 directionWithMagnitude, RayFilter filter, LayerMask layers) {
+	return GetCurrentManager()->CastSphere(origin, radius, directionWithMagnitude, filter, layers);
+}
+
+std::vector<engine::physics::ShapeCastResult> engine::physics::CastCapsule(glm::vec3 origin, glm::quat rotation, float height, float radius, glm::vec3 directionWithMagnitude, RayFilter filter, LayerMask layers) {
+	return GetCurrentManager()->CastCapsule(origin, rotation, height, radius, directionWithMagnitude, filter, layers);
+}
+
+std::vector<engine::physics::Body> engine::physics::OverlapSphere(glm::vec3 center, float radius, LayerMask layers) {
+	return GetCurrentManager()->OverlapSphere(center, radius, layers);
+}
+
+std::vector<engine::physics::Body> engine::physics::OverlapBox(glm::vec3 center, glm::quat rotation, glm::vec3 size, LayerMask layers) {
+	return GetCurrentManager()->OverlapBox(center, rotation, size, layers);
+}
+
+std::vector<engine::physics::Body> engine::physics::OverlapCapsule(glm::vec3 center, glm::quat rotation, float height, float radius, LayerMask layers) {
+	return GetCurrentManager()->OverlapCapsule(center, rotation, height, radius, layers);
+}
@@ -0,0 +1,85 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <engine/physics/manager.hpp>
+#include <algorithm>
+
+std::uint64_t engine::physics::Manager::sensorPairKey(std::uint32_t idA, std::uint32_t idB) {
+	return ((std::uint64_t)std::min(idA, idB) << 32) | (std::uint64_t)std::max(idA, idB);
+}
+
+void engine::physics::Manager::updateSensors() {
+	std::span<const InternalContactListener::SensorChange> changes = contactListener->GetSensorChanges();
+	if (changes.empty()) {
+		return;
+	}
+	// Job threads record changes in a nondeterministic order. Within a pair, added contacts are counted before removed
+	// ones, so that a body moving from one sub shape to another does not briefly end its overlap.
+	sensorChangeOrder.assign(changes.begin(), changes.end());
+	std::sort(sensorChangeOrder.begin(), sensorChangeOrder.end(), [](const InternalContactListener::SensorChange& lhs, const InternalContactListener::SensorChange& rhs) {
+		std::uint64_t lhsKey = sensorPairKey(lhs.SensorID, lhs.OtherID);
+		std::uint64_t rhsKey = sensorPairKey(rhs.SensorID, rhs.OtherID);
+		if (lhsKey != rhsKey) {
+			return lhsKey < rhsKey;
+		}
+		return lhs.Type < rhs.Type;
+	});
+	contactListener->ClearSensorChanges();
+	// Jolt reports a contact for every pair of sub shapes, so a body only begins overlapping a sensor with its first
+	// contact, and only ends once its last contact has been removed.
+	for (const InternalContactListener::SensorChange& change: sensorChangeOrder) {
+		std::uint64_t key = sensorPairKey(change.SensorID, change.OtherID);
+		Body sensor(change.SensorID, this, false);
+		Body other(change.OtherID, this, false);
+		if (change.Type == ContactEventType::Added) {
+			sensorContact& contact = sensorContacts[key];
+			if (contact.Count++ > 0) {
+				continue;
+			}
+			contact.SensorID = change.SensorID;
+			contact.OtherID = change.OtherID;
+			sensorOverlaps[change.SensorID].push_back(other);
+			sensorEvents.push_back(SensorEvent{.Type = SensorEventType::Begin, .Sensor = sensor, .Other = other});
+			continue;
+		}
+		auto found = sensorContacts.find(key);
+		if (found == sensorContacts.end() || --found->second.Count > 0) {
+			continue;
+		}
+		auto overlaps = sensorOverlaps.find(change.SensorID);
+		if (overlaps != sensorOverlaps.end()) {
+			std::erase(overlaps->second, other);
+			if (overlaps->second.empty()) {
+				sensorOverlaps.erase(overlaps);
+			}
+		}
+		sensorContacts.erase(found);
+		sensorEvents.push_back(SensorEvent{.Type = SensorEventType::End, .Sensor = sensor, .Other = other});
+	}
+}
+
+std::span<const engine::physics::SensorEvent> engine::physics::Manager::GetSensorEvents() {
+	if (asynchronous) {
+		return publishedSensorEvents;
+	}
+	return sensorEvents;
+}
+
+std::span<const engine::physics::Body> engine::physics::Manager::GetSensorOverlaps(const Body& sensor) {
+	auto overlaps = sensorOverlaps.find(sensor.GetID());
+	if (overlaps == sensorOverlaps.end()) {
+		return {};
+	}
+	return overlaps->second;
+}
+
+std::span<const engine::physics::SensorEvent> engine::physics::GetSensorEvents() {
+	return GetCurrentManager()->GetSensorEvents();
+}
+
+std::span<const engine::physics::Body> engine::physics::GetSensorOverlaps(const Body& sensor) {
+	return GetCurrentManager()->GetSensorOverlaps(sensor);
+}
@@ -0,0 +1,171 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <engine/physics/manager.hpp>
+#include <engine/log/log.hpp>
+#include <algorithm>
+#include <cstring>
+
+// Runs of unchanged bytes that are shorter than this are included in the surrounding changed run, as encoding a new run
+// costs more than the bytes that it would skip.
+const size_t minDeltaSkip = 4;
+
+engine::physics::ByteStateRecorder::ByteStateRecorder(std::vector<std::uint8_t>& output) : output(&output) {}
+
+engine::physics::ByteStateRecorder::ByteStateRecorder(std::span<const std::uint8_t> input) : input(input) {}
+
+void engine::physics::ByteStateRecorder::WriteBytes(const void* inData, size_t inNumBytes) {
+	if (!output) {
+		failed = true;
+		return;
+	}
+	auto bytes = static_cast<const std::uint8_t*>(inData);
+	output->insert(output->end(), bytes, bytes + inNumBytes);
+}
+
+void engine::physics::ByteStateRecorder::ReadBytes(void* outData, size_t inNumBytes) {
+	if (readPosition + inNumBytes > input.size()) {
+		failed = true;
+		std::memset(outData, 0, inNumBytes);
+		return;
+	}
+	std::memcpy(outData, input.data() + readPosition, inNumBytes);
+	readPosition += inNumBytes;
+}
+
+bool engine::physics::ByteStateRecorder::IsEOF() const {
+	return readPosition >= input.size();
+}
+
+bool engine::physics::ByteStateRecorder::IsFailed() const {
+	return failed;
+}
+
+static void writeVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+	while (value >= 0x80) {
+		out.push_back(std::uint8_t(value | 0x80));
+		value >>= 7;
+	}
+	out.push_back(std::uint8_t(value));
+}
+
+static bool readVarint(std::span<const std::uint8_t> in, size_t& position, std::uint64_t& value) {
+	value = 0;
+	for (unsigned shift = 0; shift < 64; shift += 7) {
+		if (position >= in.size()) {
+			return false;
+		}
+		std::uint8_t byte = in[position++];
+		value |= std::uint64_t(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void engine::physics::Manager::SaveState(PhysicsState& state) {
+	Synchronize();
+	state.Data.clear();
+	ByteStateRecorder recorder(state.Data);
+	physicsSystem->SaveState(recorder);
+}
+
+bool engine::physics::Manager::RestoreState(const PhysicsState& state) {
+	Synchronize();
+	ByteStateRecorder recorder(std::span<const std::uint8_t>(state.Data));
+	if (!physicsSystem->RestoreState(recorder) || recorder.IsFailed()) {
+		engine::log::Error("Unable to restore the physics state");
+		return false;
+	}
+	// Transforms recorded before the restore no longer lead into the current transforms, so they must not be
+	// interpolated from
+	stepCount++;
+	if (asynchronous) {
+		// Every body may have moved, including those that are asleep, and the physics thread is idle after synchronizing
+		physicsSystem->GetBodies(uncapturedBodies);
+		captureUncapturedBodies();
+	}
+	return true;
+}
+
+void engine::physics::SaveState(PhysicsState& state) {
+	GetCurrentManager()->SaveState(state);
+}
+
+bool engine::physics::RestoreState(const PhysicsState& state) {
+	return GetCurrentManager()->RestoreState(state);
+}
+
+// The delta is a header of the base and target sizes, followed by a list of runs. Each run is the number of bytes that
+// match the base since the end of the previous run, followed by the number of bytes that differ and the bytes
+// themselves. All numbers are varints. Bytes of the target that extend past the end of the base always differ.
+void engine::physics::CreateStateDelta(const PhysicsState& base, const PhysicsState& target, std::vector<std::uint8_t>& delta) {
+	const std::vector<std::uint8_t>& baseData = base.Data;
+	const std::vector<std::uint8_t>& targetData = target.Data;
+	delta.clear();
+	writeVarint(delta, baseData.size());
+	writeVarint(delta, targetData.size());
+	auto matches = [&](size_t i) { return i < baseData.size() && baseData[i] == targetData[i]; };
+	size_t runEnd = 0;
+	size_t i = 0;
+	while (i < targetData.size()) {
+		if (matches(i)) {
+			i++;
+			continue;
+		}
+		size_t runStart = i;
+		// Extends the run until enough matching bytes are found in a row to be worth skipping
+		size_t matchingCount = 0;
+		for (; i < targetData.size() && matchingCount < minDeltaSkip; i++) {
+			matchingCount = matches(i) ? matchingCount + 1 : 0;
+		}
+		size_t runLength = (i - matchingCount) - runStart;
+		writeVarint(delta, runStart - runEnd);
+		writeVarint(delta, runLength);
+		delta.insert(delta.end(), targetData.begin() + (std::ptrdiff_t)runStart, targetData.begin() + (std::ptrdiff_t)(runStart + runLength));
+		runEnd = runStart + runLength;
+	}
+}
+
+bool engine::physics::ApplyStateDelta(const PhysicsState& base, std::span<const std::uint8_t> delta, PhysicsState& target) {
+	size_t position = 0;
+	std::uint64_t baseSize, targetSize;
+	if (!readVarint(delta, position, baseSize) || !readVarint(delta, position, targetSize) || baseSize != base.Data.size()) {
+		engine::log::Error("Physics state delta does not belong to the given base state");
+		return false;
+	}
+	// Every byte of the target past the end of the base is copied from the delta, so a larger size is malformed, and is
+	// rejected before it's allocated
+	if (targetSize > base.Data.size() + delta.size()) {
+		engine::log::Error("Physics state delta is malformed");
+		return false;
+	}
+	// Decoded separately so that the target is left untouched when the delta is malformed
+	std::vector<std::uint8_t> data(targetSize);
+	std::copy_n(base.Data.begin(), std::min<size_t>(base.Data.size(), targetSize), data.begin());
+	size_t targetPosition = 0;
+	while (position < delta.size()) {
+		std::uint64_t skip, length;
+		if (!readVarint(delta, position, skip) || !readVarint(delta, position, length) ||
+			skip > targetSize - targetPosition || length > targetSize - targetPosition - skip ||
+			length > delta.size() - position) {
+			engine::log::Error("Physics state delta is malformed");
+			return false;
+		}
+		targetPosition += skip;
+		std::memcpy(data.data() + targetPosition, delta.data() + position, length);
+		targetPosition += length;
+		position += length;
+	}
+	// Any part of the target past the base that no run covered would be left uninitialized
+	if (targetSize > base.Data.size() && targetPosition < targetSize) {
+		engine::log::Error("Physics state delta is malformed");
+		return false;
+	}
+	target.Data.swap(data);
+	return true;
+}
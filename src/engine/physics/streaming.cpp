@@ -0,0 +1,265 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <engine/physics/manager.hpp>
+#include <engine/fs/fs.hpp>
+#include <engine/log/log.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Every cell file starts with this value, followed by the version and the number of bodies
+const std::uint32_t cellMagic = 0x4C4C4543; // "CELL"
+const std::uint32_t cellVersion = 2;
+
+struct engine::physics::CellStreamer::pendingCell {
+public:
+	std::int32_t X;
+	std::int32_t Z;
+	std::vector<BatchBodyCreationProperties> Bodies;
+	// Set by the job that reads the cell once the bodies may be read
+	std::atomic<bool> Done{false};
+};
+
+static std::uint64_t packCell(std::int32_t x, std::int32_t z) {
+	return ((std::uint64_t)(std::uint32_t)x << 32) | (std::uint64_t)(std::uint32_t)z;
+}
+
+static std::filesystem::path cellPath(const std::filesystem::path& directory, std::int32_t x, std::int32_t z) {
+	return directory / (std::to_string(x) + "_" + std::to_string(z) + ".cell");
+}
+
+// Reads the bodies of a cell. A cell without a file is empty, as most of a large world usually is.
+static void readCell(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path, std::vector<engine::physics::BatchBodyCreationProperties>& bodies) {
+	if (!fileSystem.FileExists(path)) {
+		return;
+	}
+	std::unique_ptr<engine::fs::IBlob> blob = fileSystem.ReadFile(path);
+	if (!blob || engine::fs::IBlob::IsEmpty(*blob)) {
+		engine::log::Error("Unable to read the cell %s", path.string().c_str());
+		return;
+	}
+	engine::physics::ByteStateRecorder recorder(std::span<const std::uint8_t>(static_cast<const std::uint8_t*>(blob->Data()), blob->Size()));
+	std::uint32_t magic = 0;
+	std::uint32_t version = 0;
+	std::uint32_t count = 0;
+	recorder.Read(magic);
+	recorder.Read(version);
+	recorder.Read(count);
+	if (recorder.IsFailed() || magic != cellMagic || version != cellVersion) {
+		engine::log::Error("%s is not a cell, or it was written by a different version of the engine", path.string().c_str());
+		return;
+	}
+	// Each body takes more than 64 bytes, so this rejects counts that are larger than the file could hold
+	if (count > blob->Size() / 64) {
+		engine::log::Error("Cell %s is malformed", path.string().c_str());
+		return;
+	}
+	bodies.resize(count);
+	for (engine::physics::BatchBodyCreationProperties& body: bodies) {
+		bool hasLayer = false;
+		engine::physics::Layer layer = 0;
+		recorder.Read(body.Shape.Type);
+		recorder.Read(body.Shape.Size);
+		recorder.Read(body.Shape.Radius);
+		recorder.Read(body.Shape.BottomRadius);
+		recorder.Read(body.Shape.Height);
+		recorder.Read(body.Body.Position);
+		recorder.Read(body.Body.Rotation);
+		recorder.Read(body.Body.MotionType);
+		recorder.Read(body.Body.MotionQuality);
+		recorder.Read(body.Body.Mass.Density);
+		recorder.Read(body.Body.Mass.Weight);
+		recorder.Read(hasLayer);
+		recorder.Read(layer);
+		recorder.Read(body.Body.UserData);
+		if (hasLayer) {
+			body.Body.Layer = layer;
+		}
+	}
+	if (recorder.IsFailed()) {
+		engine::log::Error("Cell %s is malformed", path.string().c_str());
+		bodies.clear();
+	}
+}
+
+bool engine::physics::WriteCell(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& directory, std::int32_t x, std::int32_t z, std::span<const BatchBodyCreationProperties> bodies) {
+	std::vector<std::uint8_t> data;
+	ByteStateRecorder recorder(data);
+	recorder.Write(cellMagic);
+	recorder.Write(cellVersion);
+	recorder.Write((std::uint32_t)bodies.size());
+	for (const BatchBodyCreationProperties& body: bodies) {
+		if (body.Shape.Type > Shape::Cylinder) {
+			engine::log::Error("Cells may only hold bodies with the shapes in ShapeProperties");
+			return false;
+		}
+		recorder.Write(body.Shape.Type);
+		recorder.Write(body.Shape.Size);
+		recorder.Write(body.Shape.Radius);
+		recorder.Write(body.Shape.BottomRadius);
+		recorder.Write(body.Shape.Height);
+		recorder.Write(body.Body.Position);
+		recorder.Write(body.Body.Rotation);
+		recorder.Write(body.Body.MotionType);
+		recorder.Write(body.Body.MotionQuality);
+		recorder.Write(body.Body.Mass.Density);
+		recorder.Write(body.Body.Mass.Weight);
+		recorder.Write(body.Body.Layer.has_value());
+		recorder.Write(body.Body.Layer.value_or(0));
+		recorder.Write(body.Body.UserData);
+	}
+	std::filesystem::path path = cellPath(directory, x, z);
+	if (!fileSystem.WriteFile(path, data.data(), data.size())) {
+		engine::log::Error("Unable to write the cell %s", path.string().c_str());
+		return false;
+	}
+	return true;
+}
+
+engine::physics::CellStreamer::CellStreamer(engine::fs::IFileSystem& fileSystem, std::filesystem::path directory, const StreamingOptions& options)
+	: manager(GetCurrentManager()), fileSystem(&fileSystem), directory(std::move(directory)), options(options),
+	  loads(std::make_unique<engine::jobs::Group>()) {
+	if (this->options.UnloadRadius < this->options.LoadRadius) {
+		engine::log::Error("Streaming unload radius must not be smaller than the load radius");
+		this->options.UnloadRadius = this->options.LoadRadius;
+	}
+}
+
+engine::physics::CellStreamer::~CellStreamer() {
+	engine::jobs::Wait(*loads);
+	manager->Synchronize();
+	for (const auto& [key, bodies]: loadedCells) {
+		manager->DestroyBodies(bodies);
+	}
+}
+
+void engine::physics::CellStreamer::Update(std::span<const glm::vec3> observers) {
+	auto distanceToObservers = [&](std::int32_t x, std::int32_t z) {
+		float distance = std::numeric_limits<float>::max();
+		for (glm::vec3 observer: observers) {
+			distance = std::min(distance, distanceToCell(observer, x, z));
+		}
+		return distance;
+	};
+	bool synchronized = false;
+	auto synchronize = [&]() {
+		if (!synchronized) {
+			manager->Synchronize();
+			synchronized = true;
+		}
+	};
+
+	// Cells are only removed past the unload radius, so a cell that was just loaded is never removed right away
+	for (auto it = loadedCells.begin(); it != loadedCells.end();) {
+		std::int32_t x = (std::int32_t)(it->first >> 32);
+		std::int32_t z = (std::int32_t)(std::uint32_t)it->first;
+		if (distanceToObservers(x, z) <= options.UnloadRadius) {
+			++it;
+			continue;
+		}
+		if (!it->second.empty()) {
+			synchronize();
+			manager->DestroyBodies(it->second);
+		}
+		it = loadedCells.erase(it);
+	}
+
+	// Cells that finished loading are inserted nearest first, while cells that have since moved out of range are dropped
+	std::vector<std::pair<float, std::uint64_t>> readyCells;
+	for (auto it = pendingCells.begin(); it != pendingCells.end();) {
+		pendingCell& cell = *it->second;
+		if (!cell.Done.load(std::memory_order_acquire)) {
+			++it;
+			continue;
+		}
+		float distance = distanceToObservers(cell.X, cell.Z);
+		if (distance > options.UnloadRadius) {
+			it = pendingCells.erase(it);
+			continue;
+		}
+		readyCells.emplace_back(distance, it->first);
+		++it;
+	}
+	std::sort(readyCells.begin(), readyCells.end());
+	for (size_t i = 0; i < readyCells.size() && i < options.MaxInsertsPerUpdate; i++) {
+		auto it = pendingCells.find(readyCells[i].second);
+		std::vector<Body> bodies;
+		if (!it->second->Bodies.empty()) {
+			synchronize();
+			// Cells are inserted every few updates, so rebuilding the entire broad phase for each would cause hitches
+			bodies = manager->CreateBodies(it->second->Bodies, false);
+		}
+		loadedCells.emplace(it->first, std::move(bodies));
+		pendingCells.erase(it);
+	}
+
+	// New cells are read nearest first, so the cells around the observers are ready before the ones at the edge
+	std::vector<std::pair<float, std::uint64_t>> missingCells;
+	for (glm::vec3 observer: observers) {
+		std::int32_t minX = (std::int32_t)std::floor((observer.x - options.LoadRadius) / options.CellSize);
+		std::int32_t maxX = (std::int32_t)std::floor((observer.x + options.LoadRadius) / options.CellSize);
+		std::int32_t minZ = (std::int32_t)std::floor((observer.z - options.LoadRadius) / options.CellSize);
+		std::int32_t maxZ = (std::int32_t)std::floor((observer.z + options.LoadRadius) / options.CellSize);
+		for (std::int32_t x = minX; x <= maxX; x++) {
+			for (std::int32_t z = minZ; z <= maxZ; z++) {
+				std::uint64_t key = packCell(x, z);
+				if (loadedCells.contains(key) || pendingCells.contains(key)) {
+					continue;
+				}
+				float distance = distanceToCell(observer, x, z);
+				if (distance <= options.LoadRadius) {
+					missingCells.emplace_back(distance, key);
+				}
+			}
+		}
+	}
+	std::sort(missingCells.begin(), missingCells.end());
+	for (const auto& [distance, key]: missingCells) {
+		if (pendingCells.size() >= options.MaxPendingLoads) {
+			break;
+		}
+		// Observers that are near each other find the same cells
+		if (pendingCells.contains(key)) {
+			continue;
+		}
+		auto cell = std::make_unique<pendingCell>();
+		cell->X = (std::int32_t)(key >> 32);
+		cell->Z = (std::int32_t)(std::uint32_t)key;
+		pendingCell* loadingCell = cell.get();
+		engine::fs::IFileSystem* cellFileSystem = fileSystem;
+		std::filesystem::path path = cellPath(directory, cell->X, cell->Z);
+		pendingCells.emplace(key, std::move(cell));
+		engine::jobs::Submit([loadingCell, cellFileSystem, path]() {
+			readCell(*cellFileSystem, path, loadingCell->Bodies);
+			loadingCell->Done.store(true, std::memory_order_release);
+		}, engine::jobs::Priority::Low, loads.get());
+	}
+}
+
+std::uint32_t engine::physics::CellStreamer::GetLoadedCellCount() const {
+	return (std::uint32_t)loadedCells.size();
+}
+
+std::uint32_t engine::physics::CellStreamer::GetPendingCellCount() const {
+	return (std::uint32_t)pendingCells.size();
+}
+
+std::span<const engine::physics::Body> engine::physics::CellStreamer::GetCellBodies(std::int32_t x, std::int32_t z) const {
+	auto it = loadedCells.find(packCell(x, z));
+	if (it == loadedCells.end()) {
+		return {};
+	}
+	return it->second;
+}
+
+float engine::physics::CellStreamer::distanceToCell(glm::vec3 position, std::int32_t x, std::int32_t z) const {
+	float minX = (float)x * options.CellSize;
+	float minZ = (float)z * options.CellSize;
+	float dx = std::max({minX - position.x, 0.0f, position.x - (minX + options.CellSize)});
+	float dz = std::max({minZ - position.z, 0.0f, position.z - (minZ + options.CellSize)});
+	return std::sqrt(dx * dx + dz * dz);
+}
@@ -0,0 +1,51 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <engine/physics/manager.hpp>
+#include <engine/log/log.hpp>
+
+engine::physics::World::Scope::Scope(Manager* manager) : previousManager(SetCurrentManager(manager)) {}
+
+engine::physics::World::Scope::~Scope() {
+	SetCurrentManager(previousManager);
+}
+
+engine::physics::World::World(std::unique_ptr<Manager> manager) : manager(std::move(manager)) {}
+
+engine::physics::World::~World() {
+	// Bodies that are destroyed after their world would act on a destroyed manager, so a world that is still current is
+	// an error in the caller
+	if (GetCurrentManager() == manager.get()) {
+		engine::log::Error("A physics world was destroyed while it was still current");
+		SetCurrentManager(nullptr);
+	}
+}
+
+std::unique_ptr<engine::physics::World> engine::physics::World::Create(const PhysicsOptions& options) {
+	return std::unique_ptr<World>(new World(std::make_unique<Manager>(nullptr, options)));
+}
+
+void engine::physics::World::Update(double deltaTime) {
+	manager->Update(deltaTime);
+}
+
+void engine::physics::World::SetFixedUpdate(std::function<void(double)> function) {
+	manager->SetFixedUpdate(std::move(function));
+}
+
+engine::physics::World::Scope engine::physics::World::MakeCurrent() {
+	return Scope(manager.get());
+}
+
+void engine::physics::UpdateWorlds(std::span<World* const> worlds, double deltaTime) {
+	// Each world's steps submit their own jobs at a higher priority, so a world that starts late still finishes on the
+	// workers that have already completed theirs
+	engine::jobs::ParallelFor(worlds.size(), 1, [worlds, deltaTime](std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; i++) {
+			worlds[i]->manager->Update(deltaTime);
+		}
+	});
+}
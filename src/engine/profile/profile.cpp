@@ -0,0 +1,166 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <engine/profile/profile.hpp>
+#include <engine/fs/fs.hpp>
+#include <engine/log/log.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// Each thread records into its own buffer, so recording only takes an uncontended lock. Buffers are shared with the
+// list of buffers so that their samples outlive the thread that recorded them.
+struct threadBuffer {
+public:
+	std::mutex Mutex;
+	std::uint32_t ThreadID;
+	// The capture that the samples belong to, so that samples from an earlier capture are discarded lazily
+	std::uint64_t Capture = 0;
+	std::vector<engine::profile::Sample> Samples;
+	std::vector<engine::profile::Counter> Counters;
+};
+
+static std::atomic<bool> capturing{false};
+static std::atomic<std::uint64_t> currentCapture{0};
+static std::atomic<std::int64_t> captureStart{0};
+static std::mutex buffersMutex;
+static std::vector<std::shared_ptr<threadBuffer>> buffers;
+static thread_local std::shared_ptr<threadBuffer> localBuffer;
+
+static std::int64_t now() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static std::uint64_t sinceCaptureStart() {
+	return (std::uint64_t)std::max(now() - captureStart.load(std::memory_order_relaxed), std::int64_t(0));
+}
+
+static threadBuffer& getLocalBuffer() {
+	if (!localBuffer) {
+		localBuffer = std::make_shared<threadBuffer>();
+		std::lock_guard<std::mutex> lock(buffersMutex);
+		localBuffer->ThreadID = (std::uint32_t)buffers.size();
+		buffers.push_back(localBuffer);
+	}
+	return *localBuffer;
+}
+
+// Returns the local buffer locked for recording, after discarding the samples of any earlier capture.
+static std::unique_lock<std::mutex> lockLocalBuffer(threadBuffer*& buffer) {
+	buffer = &getLocalBuffer();
+	std::unique_lock<std::mutex> lock(buffer->Mutex);
+	std::uint64_t capture = currentCapture.load(std::memory_order_acquire);
+	if (buffer->Capture != capture) {
+		buffer->Capture = capture;
+		buffer->Samples.clear();
+		buffer->Counters.clear();
+	}
+	return lock;
+}
+
+static void appendEscaped(std::string& out, const char* text) {
+	for (; *text != '\0'; text++) {
+		if (*text == '"' || *text == '\\') {
+			out.push_back('\\');
+		}
+		// Control characters are not valid within a JSON string
+		out.push_back(((unsigned char)*text < 0x20) ? ' ' : *text);
+	}
+}
+
+engine::profile::Scope::Scope(const char* name) : name(name), start(0) {
+	if (capturing.load(std::memory_order_relaxed)) {
+		start = sinceCaptureStart() + 1;
+	}
+}
+
+engine::profile::Scope::~Scope() {
+	// A start of zero means that the capture was not running when the scope began
+	if (start == 0 || !capturing.load(std::memory_order_relaxed)) {
+		return;
+	}
+	std::uint64_t end = sinceCaptureStart() + 1;
+	threadBuffer* buffer;
+	auto lock = lockLocalBuffer(buffer);
+	buffer->Samples.push_back(Sample{.Name = name, .ThreadID = buffer->ThreadID, .Start = start - 1, .Duration = end - start});
+}
+
+void engine::profile::BeginCapture() {
+	captureStart.store(now(), std::memory_order_relaxed);
+	currentCapture.fetch_add(1, std::memory_order_release);
+	capturing.store(true, std::memory_order_release);
+}
+
+void engine::profile::EndCapture() {
+	capturing.store(false, std::memory_order_release);
+}
+
+bool engine::profile::IsCapturing() {
+	return capturing.load(std::memory_order_relaxed);
+}
+
+void engine::profile::RecordCounter(const char* name, double value) {
+	if (!capturing.load(std::memory_order_relaxed)) {
+		return;
+	}
+	std::uint64_t time = sinceCaptureStart();
+	threadBuffer* buffer;
+	auto lock = lockLocalBuffer(buffer);
+	buffer->Counters.push_back(Counter{.Name = name, .Time = time, .Value = value});
+}
+
+void engine::profile::GetCapture(std::vector<Sample>& samples, std::vector<Counter>& counters) {
+	samples.clear();
+	counters.clear();
+	std::uint64_t capture = currentCapture.load(std::memory_order_acquire);
+	std::lock_guard<std::mutex> buffersLock(buffersMutex);
+	for (const std::shared_ptr<threadBuffer>& buffer: buffers) {
+		std::lock_guard<std::mutex> lock(buffer->Mutex);
+		if (buffer->Capture != capture) {
+			continue;
+		}
+		samples.insert(samples.end(), buffer->Samples.begin(), buffer->Samples.end());
+		counters.insert(counters.end(), buffer->Counters.begin(), buffer->Counters.end());
+	}
+	std::sort(samples.begin(), samples.end(), [](const Sample& lhs, const Sample& rhs) { return lhs.Start < rhs.Start; });
+	std::sort(counters.begin(), counters.end(), [](const Counter& lhs, const Counter& rhs) { return lhs.Time < rhs.Time; });
+}
+
+bool engine::profile::WriteChromeTrace(engine::fs::IFileSystem& fileSystem, const std::filesystem::path& path) {
+	std::vector<Sample> samples;
+	std::vector<Counter> counters;
+	GetCapture(samples, counters);
+	// Trace event times are in microseconds
+	std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	char number[96];
+	bool first = true;
+	for (const Sample& sample: samples) {
+		json += first ? "{\"name\":\"" : ",{\"name\":\"";
+		first = false;
+		appendEscaped(json, sample.Name);
+		std::snprintf(number, sizeof(number), "\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+					  sample.ThreadID, (double)sample.Start / 1000.0, (double)sample.Duration / 1000.0);
+		json += number;
+	}
+	for (const Counter& counter: counters) {
+		json += first ? "{\"name\":\"" : ",{\"name\":\"";
+		first = false;
+		appendEscaped(json, counter.Name);
+		std::snprintf(number, sizeof(number), "\",\"ph\":\"C\",\"pid\":0,\"ts\":%.3f,\"args\":{\"value\":%.17g}}",
+					  (double)counter.Time / 1000.0, counter.Value);
+		json += number;
+	}
+	json += "]}";
+	if (!fileSystem.WriteFile(path, json.data(), json.size())) {
+		engine::log::Error("Unable to write the profile capture to %s", path.string().c_str());
+		return false;
+	}
+	return true;
+}
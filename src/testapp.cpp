@@ -4,13 +4,176 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
+#ifndef ENGINE_HEADLESS
+
 #include <engine/application.hpp>
+#include <chrono>
 #include <iostream>
+#include <random>
+#include <thread>
 
 struct ApplicationData {
 	Rml::String TestString = "some string of text";
 } RmlTestData;
 
+// Pushes the given number of items from each producer thread, alternating between single and batched pushes, while
+// the calling thread consumes them. Returns the number of items per second, or 0 if any producer's items were lost,
+// duplicated or reordered.
+template<typename Queue>
+static double stressTestQueue(Queue& queue, std::uint32_t producers, std::uint32_t itemsPerProducer) {
+	std::atomic<bool> started = false;
+	std::atomic<std::uint32_t> finished = 0;
+	std::vector<std::thread> threads;
+	for (std::uint32_t producer = 0; producer < producers; producer++) {
+		threads.emplace_back([&queue, &started, &finished, producer, itemsPerProducer]() {
+			while (!started.load(std::memory_order_acquire)) {
+				std::this_thread::yield();
+			}
+			std::uint64_t batch[16];
+			std::uint32_t sent = 0;
+			while (sent < itemsPerProducer) {
+				// Each item holds its producer in the upper half and its sequence in the lower half
+				if (queue.Push(((std::uint64_t)producer << 32) | sent)) {
+					sent++;
+				}
+				std::uint32_t count = std::min<std::uint32_t>(16, itemsPerProducer - sent);
+				for (std::uint32_t i = 0; i < count; i++) {
+					batch[i] = ((std::uint64_t)producer << 32) | (sent + i);
+				}
+				std::size_t pushed = queue.PushBatch(batch, count);
+				if (pushed == 0) {
+					// Let the consumer catch up, rather than spinning against a full queue
+					std::this_thread::yield();
+				}
+				sent += (std::uint32_t)pushed;
+			}
+			finished.fetch_add(1, std::memory_order_release);
+		});
+	}
+	std::vector<std::uint32_t> expected(producers, 0);
+	std::uint64_t total = (std::uint64_t)producers * itemsPerProducer;
+	std::uint64_t received = 0;
+	bool valid = true;
+	std::uint64_t items[64];
+	auto start = std::chrono::high_resolution_clock::now();
+	started.store(true, std::memory_order_release);
+	while (received < total) {
+		// Once every producer has finished, an empty queue means that items were lost
+		bool producersFinished = finished.load(std::memory_order_acquire) == producers;
+		std::size_t count = queue.PopBatch(items, 64);
+		if (count == 0 && producersFinished) {
+			valid = false;
+			break;
+		} else if (count == 0) {
+			std::this_thread::yield();
+		}
+		for (std::size_t i = 0; i < count; i++) {
+			auto producer = (std::uint32_t)(items[i] >> 32);
+			if (producer >= producers || (std::uint32_t)items[i] != expected[producer]) {
+				valid = false;
+			} else {
+				expected[producer]++;
+			}
+		}
+		received += count;
+	}
+	std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+	for (auto& thread: threads) {
+		thread.join();
+	}
+	return valid ? (double)total / duration.count() : 0.0;
+}
+
+// Checks the SlotMap's erasure, slot reuse and generation handling. Returns what was being checked when a check failed,
+// or nullptr if every check passed.
+static const char* checkSlotMap() {
+	auto holds = [](const auto& map, engine::utils::SlotHandle handle, int value) {
+		const int* element = map.Get(handle);
+		return element && *element == value;
+	};
+
+	engine::utils::SlotMap<int> map;
+	engine::utils::SlotHandle a = map.Insert(1);
+	engine::utils::SlotHandle b = map.Insert(2);
+	engine::utils::SlotHandle c = map.Insert(3);
+	if (!map.Erase(c) || map.Size() != 2 || map.Contains(c) || map.Get(c) || !holds(map, a, 1) || !holds(map, b, 2)) {
+		return "erasing the last element";
+	}
+	engine::utils::SlotHandle d = map.Insert(4);
+	// The last element is moved into the erased element's place, so its slot must be pointed at its new position
+	if (!map.Erase(b) || map.Size() != 2 || !holds(map, a, 1) || !holds(map, d, 4) || map.HandleAt(1) != d) {
+		return "erasing a middle element";
+	}
+	engine::utils::SlotHandle e = map.Insert(5);
+	if (e.Index != b.Index || e.Generation == b.Generation || !holds(map, e, 5)) {
+		return "reinserting into a freed slot";
+	}
+	if (map.Contains(b) || map.Get(b) || map.Erase(b) || map.Size() != 3 || !holds(map, e, 5)) {
+		return "using a stale handle";
+	}
+
+	engine::utils::SlotMap<int, 2> wrapping;
+	engine::utils::SlotHandle original = wrapping.Insert(0);
+	// Frees another slot first, so that the original's slot links to a slot number that's also a valid dense index
+	for (int i = 1; i <= 4; i++) {
+		wrapping.Insert(i);
+	}
+	wrapping.Erase(wrapping.HandleAt(2));
+	engine::utils::SlotHandle current = original;
+	for (int i = 5; i <= 7; i++) {
+		wrapping.Erase(current);
+		current = wrapping.Insert(i);
+	}
+	// The fourth erasure wraps the generation back around to the original handle's while the slot is free
+	wrapping.Erase(current);
+	if (current.Index != original.Index || current.Generation != 3 || wrapping.Contains(original) || wrapping.Get(original) || wrapping.Erase(original)) {
+		return "wrapping the generation around";
+	}
+	// A handle that is old enough for the generation to wrap around becomes valid again once its slot is reused
+	current = wrapping.Insert(8);
+	if (current != original || !holds(wrapping, original, 8)) {
+		return "reusing a slot after the generation wrapped around";
+	}
+
+	// Random insertions and erasures, after which every live handle must still resolve to its own element
+	std::mt19937 random(1);
+	engine::utils::SlotMap<int> randomMap;
+	std::vector<std::pair<engine::utils::SlotHandle, int>> live;
+	std::vector<engine::utils::SlotHandle> erased;
+	for (int i = 0; i < 10000; i++) {
+		if (live.empty() || random() % 3 != 0) {
+			live.emplace_back(randomMap.Insert(i), i);
+			continue;
+		}
+		std::size_t index = random() % live.size();
+		if (!randomMap.Erase(live[index].first)) {
+			return "erasing a random element";
+		}
+		erased.push_back(live[index].first);
+		live[index] = live.back();
+		live.pop_back();
+	}
+	if (randomMap.Size() != live.size()) {
+		return "counting the elements after random erasures";
+	}
+	for (const auto& [handle, value]: live) {
+		if (!holds(randomMap, handle, value)) {
+			return "looking up an element after random erasures";
+		}
+	}
+	for (const engine::utils::SlotHandle& handle: erased) {
+		if (randomMap.Contains(handle)) {
+			return "looking up an erased element after random erasures";
+		}
+	}
+	for (std::size_t i = 0; i < randomMap.Size(); i++) {
+		if (randomMap.Get(randomMap.HandleAt(i)) != randomMap.begin() + i) {
+			return "mapping the dense storage back to its handles";
+		}
+	}
+	return nullptr;
+}
+
 class DemoRender : public engine::Application {
 public:
 	DemoRender() = default;
@@ -164,6 +327,7 @@ public:
 		if (ImGui::Button("Spawn")) {
 			allBodies.emplace_back(engine::physics::CreateBox({1, 1, 1}, engine::physics::BodyCreationProperties{
 				.Position = {cubeSpawn.x, 3.0f, cubeSpawn.y},
+				.UserData = allBodies.size(), // Lets hits find the cube's index in allBodies without searching
 			}));
 		}
 		ImGui::Separator(); // Cast a ray against all bodies in the world space
@@ -209,7 +373,9 @@ public:
 			ImGui::Text("Hits");
 			for (auto& hit: hits) {
 				glm::vec3 position = hit.ContactPoint;
-				ImGui::BulletText("%u: %.2f, %.2f, %.2f", hit.Body.GetID(), position.x, position.y, position.z);
+				glm::vec3 normal = hit.Normal;
+				ImGui::BulletText("%u (index %llu): %.2f, %.2f, %.2f (normal %.2f, %.2f, %.2f)", hit.Body.GetID(), (unsigned long long)hit.UserData,
+					position.x, position.y, position.z, normal.x, normal.y, normal.z);
 			}
 		}
 		ImGui::Separator(); // Handle checking a ray against a single body
@@ -245,6 +411,159 @@ public:
 		} else if (lastTarget != nullptr) {
 			ImGui::Text("%u: Missed or Obstructed", lastTarget->GetID());
 		}
+		ImGui::Separator(); // Compare casting rays one at a time against casting them in a batch
+		ImGui::Text("Benchmark casting many rays");
+		static int benchmarkRayCount = 10000;
+		ImGui::InputInt("Ray Count", &benchmarkRayCount);
+		static double singleRaysPerSecond = 0.0;
+		static double batchRaysPerSecond = 0.0;
+		static int batchHitCount = 0;
+		if (ImGui::Button("Run Benchmark##button_ray_benchmark") && benchmarkRayCount > 0) {
+			std::mt19937 rng(1337);
+			std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+			std::vector<engine::physics::Ray> rays(benchmarkRayCount);
+			for (auto& ray: rays) {
+				ray.Origin = rayPos;
+				ray.DirectionWithMagnitude = glm::normalize(glm::vec3(distribution(rng), distribution(rng), distribution(rng)) + glm::vec3(0.0f, 0.0f, 0.001f)) * rayMagnitude;
+			}
+			auto start = std::chrono::high_resolution_clock::now();
+			for (const auto& ray: rays) {
+				auto result = engine::physics::CastRay(ray.Origin, ray.DirectionWithMagnitude, engine::physics::RayFilter::ClosestHit);
+			}
+			std::chrono::duration<double> singleDuration = std::chrono::high_resolution_clock::now() - start;
+			std::vector<engine::physics::RayResult> results(benchmarkRayCount);
+			start = std::chrono::high_resolution_clock::now();
+			engine::physics::CastRays(rays, engine::physics::RayFilter::ClosestHit, results);
+			std::chrono::duration<double> batchDuration = std::chrono::high_resolution_clock::now() - start;
+			singleRaysPerSecond = (double)benchmarkRayCount / singleDuration.count();
+			batchRaysPerSecond = (double)benchmarkRayCount / batchDuration.count();
+			batchHitCount = (int)std::count_if(results.begin(), results.end(), [](const engine::physics::RayResult& result) {
+				return result.Body.IsValid();
+			});
+		}
+		if (batchRaysPerSecond > 0.0) {
+			ImGui::BulletText("CastRay: %.0f rays/s", singleRaysPerSecond);
+			ImGui::BulletText("CastRays: %.0f rays/s (%d hits)", batchRaysPerSecond, batchHitCount);
+		}
+		ImGui::Separator(); // Compare moving kinematic bodies one at a time against moving them through a command buffer
+		ImGui::Text("Benchmark moving many kinematic bodies");
+		static int benchmarkBodyCount = 5000;
+		ImGui::InputInt("Body Count", &benchmarkBodyCount);
+		static double singleCommandsPerSecond = 0.0;
+		static double bufferedCommandsPerSecond = 0.0;
+		if (ImGui::Button("Run Benchmark##button_command_benchmark") && benchmarkBodyCount > 0) {
+			// The bodies are created in their own world, so that they don't disturb the scene
+			auto world = engine::physics::World::Create(engine::physics::PhysicsOptions{});
+			std::vector<engine::physics::BatchBodyCreationProperties> properties(benchmarkBodyCount);
+			std::vector<glm::vec3> targets(benchmarkBodyCount);
+			for (int i = 0; i < benchmarkBodyCount; i++) {
+				properties[i].Body.Position = glm::vec3((float)(i % 100) * 2.0f, 0.0f, (float)(i / 100) * 2.0f);
+				properties[i].Body.MotionType = engine::physics::MotionType::Kinematic;
+				targets[i] = properties[i].Body.Position + glm::vec3(0.0f, 1.0f, 0.0f);
+			}
+			auto scope = world->MakeCurrent();
+			std::vector<engine::physics::Body> platforms = engine::physics::CreateBodies(properties);
+			auto start = std::chrono::high_resolution_clock::now();
+			for (size_t i = 0; i < platforms.size(); i++) {
+				platforms[i].MoveKinematic(targets[i], glm::identity<glm::quat>(), 1.0f / 60.0f);
+			}
+			std::chrono::duration<double> singleDuration = std::chrono::high_resolution_clock::now() - start;
+			engine::physics::CommandBuffer commands;
+			start = std::chrono::high_resolution_clock::now();
+			for (size_t i = 0; i < platforms.size(); i++) {
+				commands.MoveKinematic(platforms[i], targets[i], glm::identity<glm::quat>(), 1.0f / 60.0f);
+			}
+			engine::physics::SubmitCommands(commands);
+			// Submitted commands are applied at the start of the update, and no time passes so no step is simulated
+			world->Update(0.0);
+			std::chrono::duration<double> bufferedDuration = std::chrono::high_resolution_clock::now() - start;
+			singleCommandsPerSecond = (double)platforms.size() / singleDuration.count();
+			bufferedCommandsPerSecond = (double)platforms.size() / bufferedDuration.count();
+			engine::physics::DestroyBodies(platforms);
+		}
+		if (bufferedCommandsPerSecond > 0.0) {
+			ImGui::BulletText("Body::MoveKinematic: %.0f bodies/s", singleCommandsPerSecond);
+			ImGui::BulletText("CommandBuffer::MoveKinematic: %.0f bodies/s", bufferedCommandsPerSecond);
+		}
+		ImGui::Separator(); // Hand items between threads through the lock-free queues, checking that none are lost or reordered
+		ImGui::Text("Stress test the lock-free queues");
+		static int queueProducers = 4;
+		static int queueItems = 1000000;
+		ImGui::InputInt("Producers", &queueProducers);
+		ImGui::InputInt("Items per Producer", &queueItems);
+		static bool queuesTested = false;
+		static double spscItemsPerSecond = 0.0;
+		static double mpscItemsPerSecond = 0.0;
+		if (ImGui::Button("Run Stress Test##button_queue_stress_test") && queueProducers > 0 && queueItems > 0) {
+			// Small capacities keep the queues full, so that the producers regularly contend with the consumer
+			engine::utils::SPSCQueue<std::uint64_t> spscQueue(256);
+			spscItemsPerSecond = stressTestQueue(spscQueue, 1, (std::uint32_t)queueItems);
+			engine::utils::MPSCQueue<std::uint64_t> mpscQueue(256);
+			mpscItemsPerSecond = stressTestQueue(mpscQueue, (std::uint32_t)queueProducers, (std::uint32_t)queueItems);
+			queuesTested = true;
+		}
+		if (queuesTested) {
+			if (spscItemsPerSecond > 0.0) {
+				ImGui::BulletText("SPSCQueue (1 producer): %.0f items/s", spscItemsPerSecond);
+			} else {
+				ImGui::BulletText("SPSCQueue (1 producer): items were lost or reordered");
+			}
+			if (mpscItemsPerSecond > 0.0) {
+				ImGui::BulletText("MPSCQueue (%d producers): %.0f items/s", queueProducers, mpscItemsPerSecond);
+			} else {
+				ImGui::BulletText("MPSCQueue (%d producers): items were lost or reordered", queueProducers);
+			}
+		}
+		ImGui::Separator(); // Check that the slot map's handles stay valid across erasures and slot reuse
+		ImGui::Text("Check the slot map");
+		static bool slotMapChecked = false;
+		static const char* slotMapFailure = nullptr;
+		if (ImGui::Button("Run Checks##button_slot_map_checks")) {
+			slotMapFailure = checkSlotMap();
+			slotMapChecked = true;
+		}
+		if (slotMapChecked) {
+			if (slotMapFailure) {
+				ImGui::BulletText("SlotMap failed when %s", slotMapFailure);
+			} else {
+				ImGui::BulletText("SlotMap passed every check");
+			}
+		}
+		ImGui::Separator(); // Simulate the current scene twice from the same state and compare each step's hash
+		ImGui::Text("Verify that the simulation is deterministic");
+		static int determinismSteps = 120;
+		ImGui::InputInt("Steps", &determinismSteps);
+		static bool determinismVerified = false;
+		static engine::physics::DeterminismResult determinismResult;
+		if (ImGui::Button("Verify Determinism##button_verify_determinism") && determinismSteps > 0) {
+			determinismResult = engine::physics::VerifyDeterminism((std::uint32_t)determinismSteps);
+			determinismVerified = true;
+		}
+		if (determinismVerified) {
+			if (determinismResult.Deterministic) {
+				ImGui::BulletText("Deterministic over %d steps", determinismSteps);
+			} else {
+				ImGui::BulletText("Diverged at step %u (%016llx != %016llx)", determinismResult.FirstDivergentStep,
+					(unsigned long long)determinismResult.ExpectedHash, (unsigned long long)determinismResult.ActualHash);
+			}
+		}
+		ImGui::Separator(); // Capture the physics steps of the following frames into a trace for chrome://tracing
+		ImGui::Text("Profile the physics steps");
+		static int profileFrames = 60;
+		static int profileFramesLeft = 0;
+		ImGui::InputInt("Frames", &profileFrames);
+		if (ImGui::Button("Capture Trace##button_capture_trace") && profileFrames > 0 && profileFramesLeft == 0) {
+			engine::profile::BeginCapture();
+			profileFramesLeft = profileFrames;
+		} else if (profileFramesLeft > 0 && --profileFramesLeft == 0) {
+			engine::profile::EndCapture();
+			engine::fs::NativeFileSystem fileSystem;
+			engine::profile::WriteChromeTrace(fileSystem, "physics-trace.json");
+		}
+		for (const engine::physics::PhysicsStepStats& stats: engine::physics::GetStepStats()) {
+			ImGui::BulletText("Step: %.3fms, %u/%u active bodies, %u contact manifolds, %zu bytes temp", stats.Duration * 1000.0,
+				stats.ActiveBodies, stats.Bodies, stats.ContactManifolds, stats.TempAllocatorUsage);
+		}
 		ImGui::Separator();
 		if (!allBodies.empty()) {
 			ImGui::Text("All Bodies");
@@ -437,3 +756,5 @@ private:
 engine::Application* engine::NewApplication() {
 	return new DemoRender();
 }
+
+#endif //ENGINE_HEADLESS
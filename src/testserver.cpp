@@ -0,0 +1,92 @@
+// Copyright © 2022-2023 Daylon Wilkins & James Cor
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifdef ENGINE_HEADLESS
+
+#include <algorithm>
+
+#include <engine/application.hpp>
+
+// Simulates a pile of falling boxes without a window, and reports the physics usage once per second
+class DemoServer : public engine::Application {
+public:
+	DemoServer() = default;
+	~DemoServer() override = default;
+
+	bool Initialize() override {
+		std::vector<engine::physics::BatchBodyCreationProperties> properties;
+		properties.push_back(engine::physics::BatchBodyCreationProperties{
+			.Shape = {.Size = {100.0f, 1.0f, 100.0f}},
+			.Body = {.Position = {0.0f, -1.0f, 0.0f}, .MotionType = engine::physics::MotionType::Static},
+		});
+		for (int x = 0; x < 10; x++) {
+			for (int y = 0; y < 10; y++) {
+				for (int z = 0; z < 10; z++) {
+					properties.push_back(engine::physics::BatchBodyCreationProperties{
+						.Body = {.Position = {(float)x * 1.5f, 2.0f + (float)y * 1.5f, (float)z * 1.5f}},
+					});
+				}
+			}
+		}
+		bodies = engine::physics::CreateBodies(properties);
+		auto created = std::count_if(bodies.begin(), bodies.end(), [](const engine::physics::Body& body) {
+			return body.IsValid();
+		});
+		engine::log::Info("Created %zu of %zu bodies", (size_t)created, bodies.size());
+		return true;
+	}
+
+	void Shutdown() override {
+		engine::physics::DestroyBodies(bodies);
+	}
+
+	bool Update(double deltaTime) override {
+		elapsedTime += deltaTime;
+		for (const engine::physics::PhysicsStepStats& stats: engine::physics::GetStepStats()) {
+			stepTime += stats.Duration;
+			steps++;
+		}
+		if (elapsedTime >= 1.0) {
+			engine::log::Info("%u updates, %u steps averaging %.3fms, %u active bodies", updates, steps,
+				(steps > 0) ? (stepTime / steps) * 1000.0 : 0.0, engine::physics::GetNumberOfActiveBodies());
+			elapsedTime = 0.0;
+			stepTime = 0.0;
+			steps = 0;
+			updates = 0;
+		}
+		updates++;
+		return true;
+	}
+
+	bool FixedUpdate(double deltaTime) override {
+		return true;
+	}
+
+	bool Draw(double deltaTime) override {
+		return true;
+	}
+
+	engine::ApplicationOptions StartOptions() override {
+		engine::ApplicationOptions options{
+			.Title = "Galactic Engine Server",
+			.TickRate = 30.0,
+		};
+		return options;
+	}
+
+private:
+	std::vector<engine::physics::Body> bodies;
+	double elapsedTime = 0.0;
+	double stepTime = 0.0;
+	std::uint32_t steps = 0;
+	std::uint32_t updates = 0;
+};
+
+engine::Application* engine::NewApplication() {
+	return new DemoServer();
+}
+
+#endif //ENGINE_HEADLESS